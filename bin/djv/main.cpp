@@ -39,6 +39,7 @@ FEATHER_TK_MAIN()
     catch(const std::exception& e)
     {
         std::cerr << "ERROR: " << e.what() << std::endl;
+        r = 1;
     }
     return r;
 }
@@ -140,7 +140,7 @@ namespace djv
                 { "OpenSeparateAudio", "Open a file with separate audio." },
                 { "Close", "Close the current file." },
                 { "CloseAll", "Close all files." },
-                { "Reload", "Reload the current file." },
+                { "Reload", "Reload the current file if it has changed." },
                 { "Next", "Change to the next file." },
                 { "Prev", "Change to the previous file." },
                 { "NextLayer", "Change to the next layer." },
@@ -20,7 +20,9 @@ namespace djv
             std::shared_ptr<feather_tk::ValueObserver<bool> > frameViewObserver;
             std::shared_ptr<feather_tk::ValueObserver<tl::timeline::DisplayOptions> > displayOptionsObserver;
             std::shared_ptr<feather_tk::ValueObserver<tl::timeline::ForegroundOptions> > fgOptionsObserver;
+            std::shared_ptr<feather_tk::ValueObserver<ProxyOptions> > proxyOptionsObserver;
             std::shared_ptr<feather_tk::ValueObserver<bool> > hudObserver;
+            std::shared_ptr<feather_tk::ValueObserver<bool> > frameGraphObserver;
         };
 
         void ViewActions::_init(
@@ -157,6 +159,57 @@ namespace djv
                     }
                 });
 
+            _actions["Proxy"] = feather_tk::Action::create(
+                "USD Proxy",
+                [appWeak](bool value)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        auto options = app->getViewportModel()->getProxyOptions();
+                        options.enabled = value;
+                        app->getViewportModel()->setProxyOptions(options);
+                    }
+                });
+
+            _actions["ProxyHalf"] = feather_tk::Action::create(
+                "USD Proxy 1/2",
+                [appWeak]
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        ProxyOptions options;
+                        options.enabled = true;
+                        options.resolution = ProxyResolution::Half;
+                        app->getViewportModel()->setProxyOptions(options);
+                    }
+                });
+
+            _actions["ProxyQuarter"] = feather_tk::Action::create(
+                "USD Proxy 1/4",
+                [appWeak]
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        ProxyOptions options;
+                        options.enabled = true;
+                        options.resolution = ProxyResolution::Quarter;
+                        app->getViewportModel()->setProxyOptions(options);
+                    }
+                });
+
+            _actions["ProxyEighth"] = feather_tk::Action::create(
+                "USD Proxy 1/8",
+                [appWeak]
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        ProxyOptions options;
+                        options.enabled = true;
+                        options.resolution = ProxyResolution::Eighth;
+                        app->getViewportModel()->setProxyOptions(options);
+                    }
+                });
+
             _actions["Grid"] = feather_tk::Action::create(
                 "Grid",
                 [appWeak](bool value)
@@ -179,14 +232,40 @@ namespace djv
                     }
                 });
 
+            _actions["FrameGraph"] = feather_tk::Action::create(
+                "Frame Graph",
+                [appWeak](bool value)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        app->getViewportModel()->setFrameGraph(value);
+                    }
+                });
+
+            _actions["FrameTiming"] = feather_tk::Action::create(
+                "Write Frame Timing",
+                [appWeak]
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        app->writeFrameTiming();
+                    }
+                });
+
             _tooltips =
             {
                 { "Frame",  "Frame the view to fit the window." },
                 { "ZoomReset", "Reset the view zoom to 1:1." },
                 { "ZoomIn", "Zoom the view in." },
                 { "ZoomOut", "Zoom the view out." },
+                { "Proxy", "Toggle between full and proxy resolution USD rendering." },
+                { "ProxyHalf", "Render USD files at half resolution." },
+                { "ProxyQuarter", "Render USD files at quarter resolution." },
+                { "ProxyEighth", "Render USD files at eighth resolution." },
                 { "Grid", "Toggle the grid." },
-                { "HUD", "Toggle the HUD (Heads Up Display)." }
+                { "HUD", "Toggle the HUD (Heads Up Display)." },
+                { "FrameGraph", "Toggle the frame timing graph in the HUD." },
+                { "FrameTiming", "Write the frame timing as a Chrome trace JSON file." }
             };
 
             _shortcutsUpdate(app->getSettingsModel()->getShortcuts());
@@ -218,12 +297,32 @@ namespace djv
                     _actions["Grid"]->setChecked(value.grid.enabled);
                 });
 
+            p.proxyOptionsObserver = feather_tk::ValueObserver<ProxyOptions>::create(
+                app->getViewportModel()->observeProxyOptions(),
+                [this](const ProxyOptions& value)
+                {
+                    _actions["Proxy"]->setChecked(value.enabled);
+                    _actions["ProxyHalf"]->setChecked(
+                        value.enabled && ProxyResolution::Half == value.resolution);
+                    _actions["ProxyQuarter"]->setChecked(
+                        value.enabled && ProxyResolution::Quarter == value.resolution);
+                    _actions["ProxyEighth"]->setChecked(
+                        value.enabled && ProxyResolution::Eighth == value.resolution);
+                });
+
             p.hudObserver = feather_tk::ValueObserver<bool>::create(
                 app->getViewportModel()->observeHUD(),
                 [this](bool value)
                 {
                     _actions["HUD"]->setChecked(value);
                 });
+
+            p.frameGraphObserver = feather_tk::ValueObserver<bool>::create(
+                app->getViewportModel()->observeFrameGraph(),
+                [this](bool value)
+                {
+                    _actions["FrameGraph"]->setChecked(value);
+                });
         }
 
         ViewActions::ViewActions() :
@@ -4,13 +4,23 @@
 
 #include <djvApp/App.h>
 
+#include <djvApp/Export/ExportQueue.h>
 #include <djvApp/Models/AudioModel.h>
+#include <djvApp/Models/CacheModel.h>
 #include <djvApp/Models/ColorModel.h>
+#include <djvApp/Models/FileWatcherModel.h>
 #include <djvApp/Models/FilesModel.h>
+#include <djvApp/Models/FrameCacheModel.h>
+#include <djvApp/Models/FrameTimingModel.h>
+#include <djvApp/Models/ReadAheadModel.h>
 #include <djvApp/Models/RecentFilesModel.h>
+#include <djvApp/Models/SharedCacheModel.h>
+#include <djvApp/Models/ThumbnailCacheModel.h>
+#include <djvApp/Models/ThumbnailScheduler.h>
 #include <djvApp/Models/TimeUnitsModel.h>
 #include <djvApp/Models/ToolsModel.h>
 #include <djvApp/Models/ViewportModel.h>
+#include <djvApp/Models/WaveformModel.h>
 #if defined(TLRENDER_BMD)
 #include <djvApp/Models/BMDDevicesModel.h>
 #endif // TLRENDER_BMD
@@ -42,16 +52,103 @@
 
 #include <feather-tk/ui/FileBrowser.h>
 #include <feather-tk/ui/Settings.h>
+#include <feather-tk/gl/Window.h>
 #include <feather-tk/core/CmdLine.h>
 #include <feather-tk/core/File.h>
 #include <feather-tk/core/Format.h>
+#include <feather-tk/core/String.h>
 
+#include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <list>
+#include <map>
+#include <optional>
+#include <thread>
 
 namespace djv
 {
     namespace app
     {
+        namespace
+        {
+#if defined(TLRENDER_USD)
+            bool isUSD(const tl::file::Path& path)
+            {
+                const std::string extension = feather_tk::toLower(path.getExtension());
+                return
+                    ".usd" == extension ||
+                    ".usda" == extension ||
+                    ".usdc" == extension ||
+                    ".usdz" == extension;
+            }
+#endif // TLRENDER_USD
+
+            std::map<std::string, FileStamp> getTimelineStamps(
+                const tl::file::Path& path,
+                const tl::file::Path& audioPath)
+            {
+                std::map<std::string, FileStamp> out = getFileStamps(path);
+                if (!audioPath.isEmpty())
+                {
+                    const std::map<std::string, FileStamp> audio = getFileStamps(audioPath);
+                    out.insert(audio.begin(), audio.end());
+                }
+                return out;
+            }
+
+            //! Compare the file stamps, and remove the files that have
+            //! changed from the frame cache. Returns whether any files have
+            //! changed.
+            bool compareStamps(
+                const std::map<std::string, FileStamp>& prev,
+                const std::map<std::string, FileStamp>& stamps,
+                const std::shared_ptr<FrameCacheModel>& frameCacheModel)
+            {
+                bool out = false;
+                for (const auto& stamp : stamps)
+                {
+                    const auto i = prev.find(stamp.first);
+                    if (i == prev.end() || i->second != stamp.second)
+                    {
+                        frameCacheModel->remove(stamp.first);
+                        out = true;
+                    }
+                }
+                for (const auto& stamp : prev)
+                {
+                    if (stamps.find(stamp.first) == stamps.end())
+                    {
+                        frameCacheModel->remove(stamp.first);
+                        out = true;
+                    }
+                }
+                return out;
+            }
+
+            //! The number of frames that can be added to an image sequence
+            //! during playback before it is reloaded.
+            const int64_t appendFramesMax = 24;
+
+            std::string getDirectory(const tl::file::Path& path)
+            {
+                return std::filesystem::u8path(path.get()).parent_path().u8string();
+            }
+
+            //! Get the in/out range of a player to save with the file. The
+            //! whole time range is saved as an invalid range, so that it is
+            //! reset when a growing image sequence is reloaded.
+            OTIO_NS::TimeRange getInOutRange(const std::shared_ptr<tl::timeline::Player>& player)
+            {
+                const OTIO_NS::TimeRange& inOutRange = player->getInOutRange();
+                return !tl::time::compareExact(inOutRange, player->getTimeRange()) ?
+                    inOutRange :
+                    tl::time::invalidTimeRange;
+            }
+        }
+
         struct CmdLine
         {
             std::shared_ptr<feather_tk::CmdLineListArg<std::string> > inputs;
@@ -81,6 +178,17 @@ namespace djv
             std::shared_ptr<feather_tk::CmdLineValueOption<size_t> > usdStageCache;
             std::shared_ptr<feather_tk::CmdLineValueOption<size_t> > usdDiskCache;
 #endif // TLRENDER_USD
+            std::shared_ptr<feather_tk::CmdLineFlagOption> exportFlag;
+            std::shared_ptr<feather_tk::CmdLineValueOption<std::string> > exportSettingsFileName;
+            std::shared_ptr<feather_tk::CmdLineValueOption<std::string> > exportDirectory;
+            std::shared_ptr<feather_tk::CmdLineValueOption<ExportRenderSize> > exportRenderSize;
+            std::shared_ptr<feather_tk::CmdLineValueOption<feather_tk::Size2I> > exportCustomSize;
+            std::shared_ptr<feather_tk::CmdLineValueOption<ExportFileType> > exportFileType;
+            std::shared_ptr<feather_tk::CmdLineValueOption<std::string> > exportBaseName;
+            std::shared_ptr<feather_tk::CmdLineValueOption<size_t> > exportZeroPad;
+            std::shared_ptr<feather_tk::CmdLineValueOption<std::string> > exportExtension;
+            std::shared_ptr<feather_tk::CmdLineValueOption<std::string> > exportCodec;
+            std::shared_ptr<feather_tk::CmdLineValueOption<std::string> > frameTimingFileName;
             std::shared_ptr<feather_tk::CmdLineValueOption<std::string> > logFileName;
             std::shared_ptr<feather_tk::CmdLineFlagOption> resetSettings;
             std::shared_ptr<feather_tk::CmdLineValueOption<std::string> > settingsFileName;
@@ -90,8 +198,15 @@ namespace djv
         {
             std::filesystem::path logFile;
             std::filesystem::path settingsFile;
+            std::filesystem::path frameTimingFile;
             CmdLine cmdLine;
 
+            std::chrono::steady_clock::time_point startTime;
+            std::chrono::steady_clock::time_point startupTime;
+            std::vector<std::pair<std::string, double> > startupTimes;
+            bool startupTick = false;
+            bool startupTimeline = false;
+
             std::shared_ptr<tl::file::FileLogSystem> fileLogSystem;
             std::shared_ptr<feather_tk::Settings> settings;
             std::shared_ptr<SettingsModel> settingsModel;
@@ -101,11 +216,52 @@ namespace djv
             std::vector<std::shared_ptr<FilesModelItem> > activeFiles;
             std::shared_ptr<RecentFilesModel> recentFilesModel;
             std::vector<std::shared_ptr<tl::timeline::Timeline> > timelines;
+            struct TimelineLoad
+            {
+                std::shared_ptr<tl::timeline::Timeline> timeline;
+                std::vector<std::string> videoLayers;
+                std::map<std::string, FileStamp> stamps;
+                std::string error;
+            };
+            std::list<std::shared_ptr<FilesModelItem> > timelinesPending;
+            std::map<std::shared_ptr<FilesModelItem>, std::future<TimelineLoad> > timelinesLoading;
+            std::map<std::shared_ptr<tl::timeline::Timeline>, std::map<std::string, FileStamp> > timelineStamps;
+            struct StampsCheck
+            {
+                std::shared_ptr<FilesModelItem> item;
+                std::shared_ptr<tl::timeline::Timeline> timeline;
+                tl::file::Path audioPath;
+                std::map<std::string, FileStamp> stamps;
+                int64_t appendedFrames = 0;
+            };
+            std::vector<std::shared_ptr<FilesModelItem> > stampsPending;
+            std::future<std::vector<StampsCheck> > stampsChecking;
+            std::vector<std::shared_ptr<FilesModelItem> > appendDeferred;
+            std::vector<std::shared_ptr<FilesModelItem> > thumbnailsStale;
+            OTIO_NS::RationalTime appendTime = tl::time::invalidTime;
+            std::optional<tl::timeline::Loop> initLoop;
+            std::optional<tl::timeline::Playback> initPlayback;
             std::shared_ptr<feather_tk::ObservableValue<std::shared_ptr<tl::timeline::Player> > > player;
+            std::list<std::pair<std::shared_ptr<FilesModelItem>, std::shared_ptr<tl::timeline::Player> > > playerPool;
+            std::shared_ptr<FilesModelItem> playerReloadItem;
+            std::shared_ptr<tl::timeline::Player> playerStaged;
+            float playerVideoGB = 0.F;
+            float playerPoolVideoGB = 0.F;
+            int proxyScale = 1;
             std::shared_ptr<ColorModel> colorModel;
             std::shared_ptr<ViewportModel> viewportModel;
             std::shared_ptr<AudioModel> audioModel;
             std::shared_ptr<ToolsModel> toolsModel;
+            std::shared_ptr<ExportQueue> exportQueue;
+            std::shared_ptr<FrameTimingModel> frameTimingModel;
+            std::shared_ptr<CacheModel> cacheModel;
+            std::shared_ptr<ReadAheadModel> readAheadModel;
+            std::shared_ptr<FrameCacheModel> frameCacheModel;
+            std::shared_ptr<SharedCacheModel> sharedCacheModel;
+            std::shared_ptr<ThumbnailCacheModel> thumbnailCacheModel;
+            std::shared_ptr<ThumbnailScheduler> thumbnailScheduler;
+            std::shared_ptr<WaveformModel> waveformModel;
+            std::shared_ptr<FileWatcherModel> fileWatcherModel;
 
             std::shared_ptr<feather_tk::ObservableValue<bool> > secondaryWindowActive;
             std::shared_ptr<MainWindow> mainWindow;
@@ -120,7 +276,12 @@ namespace djv
 #endif // TLRENDER_BMD
 
             std::shared_ptr<feather_tk::ValueObserver<tl::timeline::PlayerCacheOptions> > cacheObserver;
+            std::shared_ptr<feather_tk::ValueObserver<double> > readBehindObserver;
+            std::shared_ptr<feather_tk::ValueObserver<tl::timeline::PlayerCacheInfo> > cacheInfoObserver;
+            std::shared_ptr<feather_tk::ValueObserver<PlayerPoolSettings> > playerPoolObserver;
+            std::shared_ptr<feather_tk::ValueObserver<ProxyOptions> > proxyOptionsObserver;
             std::shared_ptr<feather_tk::ListObserver<std::shared_ptr<FilesModelItem> > > filesObserver;
+            std::shared_ptr<feather_tk::ListObserver<std::string> > fileWatcherObserver;
             std::shared_ptr<feather_tk::ListObserver<std::shared_ptr<FilesModelItem> > > activeObserver;
             std::shared_ptr<feather_tk::ListObserver<int> > layersObserver;
             std::shared_ptr<feather_tk::ValueObserver<tl::timeline::CompareTime> > compareTimeObserver;
@@ -158,6 +319,7 @@ namespace djv
             const std::filesystem::path appDocsPath = _appDocsPath();
             p.logFile = _getLogFilePath(appName, appDocsPath);
             p.settingsFile = _getSettingsPath(appName, appDocsPath);
+            p.frameTimingFile = appDocsPath / "FrameTiming.json";
 
             p.cmdLine.inputs = feather_tk::CmdLineListArg<std::string>::create(
                 "input",
@@ -279,6 +441,55 @@ namespace djv
                 "USD",
                 0);
 #endif // TLRENDER_USD
+            p.cmdLine.exportFlag = feather_tk::CmdLineFlagOption::create(
+                { "-export" },
+                "Export the input and exit without opening a window.",
+                "Export");
+            p.cmdLine.exportSettingsFileName = feather_tk::CmdLineValueOption<std::string>::create(
+                { "-exportSettings" },
+                "Export settings JSON file name. Settings on the command line take precedence.",
+                "Export");
+            p.cmdLine.exportDirectory = feather_tk::CmdLineValueOption<std::string>::create(
+                { "-exportDir" },
+                "Export directory.",
+                "Export");
+            p.cmdLine.exportRenderSize = feather_tk::CmdLineValueOption<ExportRenderSize>::create(
+                { "-exportRenderSize" },
+                "Export render size.",
+                "Export",
+                std::optional<ExportRenderSize>(),
+                feather_tk::quotes(getExportRenderSizeLabels()));
+            p.cmdLine.exportCustomSize = feather_tk::CmdLineValueOption<feather_tk::Size2I>::create(
+                { "-exportCustomSize" },
+                "Export custom render size.",
+                "Export");
+            p.cmdLine.exportFileType = feather_tk::CmdLineValueOption<ExportFileType>::create(
+                { "-exportFileType" },
+                "Export file type.",
+                "Export",
+                std::optional<ExportFileType>(),
+                feather_tk::quotes(getExportFileTypeLabels()));
+            p.cmdLine.exportBaseName = feather_tk::CmdLineValueOption<std::string>::create(
+                { "-exportBaseName" },
+                "Export base name.",
+                "Export");
+            p.cmdLine.exportZeroPad = feather_tk::CmdLineValueOption<size_t>::create(
+                { "-exportZeroPad" },
+                "Export image zero padding.",
+                "Export");
+            p.cmdLine.exportExtension = feather_tk::CmdLineValueOption<std::string>::create(
+                { "-exportExtension" },
+                "Export file extension (e.g., .exr, .mov).",
+                "Export");
+            p.cmdLine.exportCodec = feather_tk::CmdLineValueOption<std::string>::create(
+                { "-exportCodec" },
+                "Export movie codec.",
+                "Export");
+            p.cmdLine.frameTimingFileName = feather_tk::CmdLineValueOption<std::string>::create(
+                { "-frameTiming" },
+                "Write the playback frame timing as a Chrome trace JSON file on exit.",
+                std::string(),
+                feather_tk::Format("{0}").arg(p.frameTimingFile.u8string()));
             p.cmdLine.logFileName = feather_tk::CmdLineValueOption<std::string>::create(
                 { "-logFile" },
                 "Log file name.",
@@ -326,6 +537,17 @@ namespace djv
                     p.cmdLine.usdStageCache,
                     p.cmdLine.usdDiskCache,
 #endif // TLRENDER_USD
+                    p.cmdLine.exportFlag,
+                    p.cmdLine.exportSettingsFileName,
+                    p.cmdLine.exportDirectory,
+                    p.cmdLine.exportRenderSize,
+                    p.cmdLine.exportCustomSize,
+                    p.cmdLine.exportFileType,
+                    p.cmdLine.exportBaseName,
+                    p.cmdLine.exportZeroPad,
+                    p.cmdLine.exportExtension,
+                    p.cmdLine.exportCodec,
+                    p.cmdLine.frameTimingFileName,
                     p.cmdLine.logFileName,
                     p.cmdLine.resetSettings,
                     p.cmdLine.settingsFileName
@@ -405,6 +627,11 @@ namespace djv
             return _p->settingsModel;
         }
 
+        const std::shared_ptr<CacheModel>& App::getCacheModel() const
+        {
+            return _p->cacheModel;
+        }
+
         const std::shared_ptr<TimeUnitsModel>& App::getTimeUnitsModel() const
         {
             return _p->timeUnitsModel;
@@ -420,37 +647,52 @@ namespace djv
             return _p->recentFilesModel;
         }
 
+        tl::timeline::Options App::getTimelineOptions() const
+        {
+            FEATHER_TK_P();
+            tl::timeline::Options out;
+            const ImageSequenceSettings imageSequence = p.settingsModel->getImageSequence();
+            out.imageSequenceAudio = imageSequence.audio;
+            out.imageSequenceAudioExtensions = imageSequence.audioExtensions;
+            out.imageSequenceAudioFileName = imageSequence.audioFileName;
+            const AdvancedSettings advanced = p.settingsModel->getAdvanced();
+            out.compat = advanced.compat;
+            out.videoRequestMax = advanced.videoRequestMax;
+            out.audioRequestMax = advanced.audioRequestMax;
+            out.ioOptions = _getIOOptions(1);
+            out.pathOptions.maxNumberDigits = imageSequence.maxDigits;
+            return out;
+        }
+
         void App::reload()
         {
             FEATHER_TK_P();
-            const auto activeFiles = p.activeFiles;
-            const auto files = p.files;
-            for (const auto& i : activeFiles)
+
+            // Compare the files with the stamps from when they were loaded.
+            std::vector<std::shared_ptr<FilesModelItem> > checks;
+            std::vector<std::shared_ptr<FilesModelItem> > items;
+            for (const auto& item : p.activeFiles)
             {
-                const auto j = std::find(p.files.begin(), p.files.end(), i);
-                if (j != p.files.end())
+                const auto i = std::find(p.files.begin(), p.files.end(), item);
+                if (i != p.files.end())
                 {
-                    const size_t index = j - p.files.begin();
-                    p.files.erase(j);
-                    p.timelines.erase(p.timelines.begin() + index);
+                    const auto timeline = p.timelines[i - p.files.begin()];
+                    if (timeline && p.timelineStamps.find(timeline) != p.timelineStamps.end())
+                    {
+                        checks.push_back(item);
+                    }
+                    else if (!timeline && p.timelinesLoading.find(item) == p.timelinesLoading.end())
+                    {
+                        // Try again to load files that failed.
+                        items.push_back(item);
+                    }
                 }
             }
-            p.activeFiles.clear();
-            if (!activeFiles.empty())
+            _stampsCheck(checks);
+            if (!items.empty())
             {
-                if (auto player = p.player->get())
-                {
-                    activeFiles.front()->speed = player->getSpeed();
-                    activeFiles.front()->currentTime = player->getCurrentTime();
-                    activeFiles.front()->inOutRange = player->getInOutRange();
-                }
+                _reload(items);
             }
-
-            auto thumbnailSytem = _context->getSystem<tl::timelineui::ThumbnailSystem>();
-            thumbnailSytem->getCache()->clear();
-
-            _filesUpdate(files);
-            _activeUpdate(activeFiles);
         }
 
         std::shared_ptr<feather_tk::IObservableValue<std::shared_ptr<tl::timeline::Player> > > App::observePlayer() const
@@ -478,6 +720,52 @@ namespace djv
             return _p->toolsModel;
         }
 
+        const std::shared_ptr<ExportQueue>& App::getExportQueue() const
+        {
+            return _p->exportQueue;
+        }
+
+        const std::shared_ptr<FrameCacheModel>& App::getFrameCacheModel() const
+        {
+            return _p->frameCacheModel;
+        }
+
+        const std::shared_ptr<ThumbnailCacheModel>& App::getThumbnailCacheModel() const
+        {
+            return _p->thumbnailCacheModel;
+        }
+
+        const std::shared_ptr<ThumbnailScheduler>& App::getThumbnailScheduler() const
+        {
+            return _p->thumbnailScheduler;
+        }
+
+        const std::shared_ptr<WaveformModel>& App::getWaveformModel() const
+        {
+            return _p->waveformModel;
+        }
+
+        const std::shared_ptr<FrameTimingModel>& App::getFrameTimingModel() const
+        {
+            return _p->frameTimingModel;
+        }
+
+        void App::writeFrameTiming()
+        {
+            FEATHER_TK_P();
+            try
+            {
+                p.frameTimingModel->writeTrace(p.frameTimingFile);
+                _context->log(
+                    "djv::app::App",
+                    feather_tk::Format("Wrote frame timing: {0}").arg(p.frameTimingFile.u8string()));
+            }
+            catch (const std::exception& e)
+            {
+                _context->log("djv::app::App", e.what(), feather_tk::LogType::Error);
+            }
+        }
+
         const std::shared_ptr<MainWindow>& App::getMainWindow() const
         {
             return _p->mainWindow;
@@ -563,29 +851,70 @@ namespace djv
         {
             FEATHER_TK_P();
 
+            p.startTime = std::chrono::steady_clock::now();
+            p.startupTime = p.startTime;
+
+            if (p.cmdLine.frameTimingFileName->hasValue())
+            {
+                p.frameTimingFile = std::filesystem::u8path(p.cmdLine.frameTimingFileName->getValue());
+            }
+
             p.fileLogSystem = tl::file::FileLogSystem::create(_context, p.logFile);
 
             p.settings = feather_tk::Settings::create(
                 _context,
                 p.settingsFile,
                 p.cmdLine.resetSettings->found());
+            _startupTime("Settings");
 
             _modelsInit();
-            _devicesInit();
-            _observersInit();
-            _inputFilesInit();
-            _windowsInit();
-
-            feather_tk::App::run();
+            _startupTime("Models");
+            if (p.cmdLine.exportFlag->found())
+            {
+                _exportRun();
+            }
+            else
+            {
+                _devicesInit();
+                _startupTime("Devices");
+                _observersInit();
+                _startupTime("Observers");
+
+                // Show the window before opening the input files. The
+                // timelines are loaded asynchronously and the tools are
+                // created when they are first shown.
+                _windowsInit();
+                _startupTime("Windows");
+                _inputFilesInit();
+                _startupTime("Input files");
+
+                p.startupTick = true;
+                p.startupTimeline = !p.filesModel->getFiles().empty();
+                feather_tk::App::run();
+
+                if (p.cmdLine.frameTimingFileName->hasValue())
+                {
+                    writeFrameTiming();
+                }
+            }
         }
 
         void App::_tick()
         {
             FEATHER_TK_P();
+            if (p.startupTick)
+            {
+                p.startupTick = false;
+                _startupTime("First tick");
+            }
+            _timelinesTick();
+            _stampsTick();
             if (auto player = p.player->get())
             {
                 player->tick();
             }
+            _playerStagedTick();
+            p.exportQueue->tick();
 #if defined(TLRENDER_BMD)
             if (p.bmdOutputDevice)
             {
@@ -615,6 +944,9 @@ namespace djv
                 p.settingsModel->setStyle(style);
             }
 
+            p.cacheModel = CacheModel::create(_context, p.settingsModel);
+            p.readAheadModel = ReadAheadModel::create(_context, p.settingsModel, p.cacheModel);
+
             p.timeUnitsModel = TimeUnitsModel::create(_context, p.settings);
             
             p.filesModel = FilesModel::create(p.settings);
@@ -672,10 +1004,39 @@ namespace djv
             }
 
             p.viewportModel = ViewportModel::create(_context, p.settings);
+            p.proxyScale = getProxyScale(p.viewportModel->getProxyOptions());
 
             p.audioModel = AudioModel::create(_context, p.settings);
 
             p.toolsModel = ToolsModel::create(p.settings);
+
+            p.frameCacheModel = FrameCacheModel::create();
+            p.sharedCacheModel = SharedCacheModel::create(_context, p.settingsModel);
+            p.frameCacheModel->setSharedCache(p.sharedCacheModel);
+            p.thumbnailCacheModel = ThumbnailCacheModel::create(_context, _appDocsPath() / "Thumbnails");
+            p.thumbnailScheduler = ThumbnailScheduler::create(_context, p.thumbnailCacheModel);
+            p.waveformModel = WaveformModel::create(_context, _appDocsPath() / "Waveforms");
+            p.fileWatcherModel = FileWatcherModel::create(_context);
+
+            p.exportQueue = ExportQueue::create(_context, p.settings, p.frameCacheModel);
+
+            p.frameTimingModel = FrameTimingModel::create();
+        }
+
+        void App::_startupTime(const std::string& name)
+        {
+            FEATHER_TK_P();
+            const auto now = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> diff = now - p.startupTime;
+            const std::chrono::duration<double> total = now - p.startTime;
+            p.startupTime = now;
+            p.startupTimes.push_back(std::make_pair(name, diff.count() * 1000.0));
+            _context->log(
+                "djv::app::App",
+                feather_tk::Format("Startup: {0}: {1}ms (total: {2}ms)").
+                    arg(name).
+                    arg(diff.count() * 1000.0, 2).
+                    arg(total.count() * 1000.0, 2));
         }
 
         void App::_devicesInit()
@@ -694,13 +1055,31 @@ namespace djv
             p.player = feather_tk::ObservableValue<std::shared_ptr<tl::timeline::Player> >::create();
 
             p.cacheObserver = feather_tk::ValueObserver<tl::timeline::PlayerCacheOptions>::create(
-                p.settingsModel->observeCache(),
-                [this](const tl::timeline::PlayerCacheOptions& value)
+                p.cacheModel->observeCacheOptions(),
+                [this](const tl::timeline::PlayerCacheOptions&)
                 {
-                    if (auto player = _p->player->get())
-                    {
-                        player->setCacheOptions(value);
-                    }
+                    _cacheUpdate();
+                });
+
+            p.readBehindObserver = feather_tk::ValueObserver<double>::create(
+                p.readAheadModel->observeReadBehind(),
+                [this](double)
+                {
+                    _cacheUpdate();
+                });
+
+            p.playerPoolObserver = feather_tk::ValueObserver<PlayerPoolSettings>::create(
+                p.settingsModel->observePlayerPool(),
+                [this](const PlayerPoolSettings&)
+                {
+                    _playerPoolUpdate();
+                });
+
+            p.proxyOptionsObserver = feather_tk::ValueObserver<ProxyOptions>::create(
+                p.viewportModel->observeProxyOptions(),
+                [this](const ProxyOptions&)
+                {
+                    _ioOptionsUpdate();
                 });
 
             p.filesObserver = feather_tk::ListObserver<std::shared_ptr<FilesModelItem> >::create(
@@ -709,6 +1088,12 @@ namespace djv
                 {
                     _filesUpdate(value);
                 });
+            p.fileWatcherObserver = feather_tk::ListObserver<std::string>::create(
+                p.fileWatcherModel->observeChanged(),
+                [this](const std::vector<std::string>& value)
+                {
+                    _filesChanged(value);
+                });
             p.activeObserver = feather_tk::ListObserver<std::shared_ptr<FilesModelItem> >::create(
                 p.filesModel->observeActive(),
                 [this](const std::vector<std::shared_ptr<FilesModelItem> >& value)
@@ -913,31 +1298,33 @@ namespace djv
                         tl::file::Path(input),
                         tl::file::Path(audioFileName));
 
-                    if (auto player = p.player->get())
+                    // The timelines are loaded asynchronously, so store the
+                    // playback state to be applied when the player is created.
+                    if (auto item = p.filesModel->getA())
                     {
                         if (p.cmdLine.speed->hasValue())
                         {
-                            player->setSpeed(p.cmdLine.speed->getValue());
+                            item->speed = p.cmdLine.speed->getValue();
                         }
                         if (p.cmdLine.inOutRange->hasValue())
                         {
                             const OTIO_NS::TimeRange& inOutRange = p.cmdLine.inOutRange->getValue();
-                            player->setInOutRange(inOutRange);
-                            player->seek(inOutRange.start_time());
+                            item->inOutRange = inOutRange;
+                            item->currentTime = inOutRange.start_time();
                         }
                         if (p.cmdLine.seek->hasValue())
                         {
-                            player->seek(p.cmdLine.seek->getValue());
-                        }
-                        if (p.cmdLine.loop->hasValue())
-                        {
-                            player->setLoop(p.cmdLine.loop->getValue());
-                        }
-                        if (p.cmdLine.playback->hasValue())
-                        {
-                            player->setPlayback(p.cmdLine.playback->getValue());
+                            item->currentTime = p.cmdLine.seek->getValue();
                         }
                     }
+                    if (p.cmdLine.loop->hasValue())
+                    {
+                        p.initLoop = p.cmdLine.loop->getValue();
+                    }
+                    if (p.cmdLine.playback->hasValue())
+                    {
+                        p.initPlayback = p.cmdLine.playback->getValue();
+                    }
                 }
             }
         }
@@ -984,6 +1371,147 @@ namespace djv
                 });
         }
 
+        void App::_exportRun()
+        {
+            FEATHER_TK_P();
+            const auto& inputs = p.cmdLine.inputs->getList();
+            if (inputs.size() != 1)
+            {
+                throw std::runtime_error("Export requires a single input");
+            }
+
+            // Get the export settings, starting with the saved settings and
+            // overriding them with the settings file and command line.
+            ExportSettings settings = p.settingsModel->getExport();
+            if (p.cmdLine.exportSettingsFileName->hasValue())
+            {
+                const std::string& fileName = p.cmdLine.exportSettingsFileName->getValue();
+                std::ifstream file(std::filesystem::u8path(fileName));
+                if (!file.is_open())
+                {
+                    throw std::runtime_error(
+                        feather_tk::Format("Cannot open: \"{0}\"").arg(fileName));
+                }
+                nlohmann::json json;
+                to_json(json, settings);
+                json.update(nlohmann::json::parse(file));
+                from_json(json, settings);
+            }
+            if (p.cmdLine.exportDirectory->hasValue())
+            {
+                settings.directory = p.cmdLine.exportDirectory->getValue();
+            }
+            if (p.cmdLine.exportRenderSize->hasValue())
+            {
+                settings.renderSize = p.cmdLine.exportRenderSize->getValue();
+            }
+            if (p.cmdLine.exportCustomSize->hasValue())
+            {
+                settings.renderSize = ExportRenderSize::Custom;
+                settings.customSize = p.cmdLine.exportCustomSize->getValue();
+            }
+            if (p.cmdLine.exportFileType->hasValue())
+            {
+                settings.fileType = p.cmdLine.exportFileType->getValue();
+            }
+            const bool movie = ExportFileType::Movie == settings.fileType;
+            if (p.cmdLine.exportBaseName->hasValue())
+            {
+                (movie ? settings.movieBaseName : settings.imageBaseName) =
+                    p.cmdLine.exportBaseName->getValue();
+            }
+            if (p.cmdLine.exportZeroPad->hasValue())
+            {
+                settings.imageZeroPad = p.cmdLine.exportZeroPad->getValue();
+            }
+            if (p.cmdLine.exportExtension->hasValue())
+            {
+                (movie ? settings.movieExtension : settings.imageExtension) =
+                    p.cmdLine.exportExtension->getValue();
+            }
+            if (p.cmdLine.exportCodec->hasValue())
+            {
+                settings.movieCodec = p.cmdLine.exportCodec->getValue();
+            }
+
+            // Create a hidden window for the OpenGL context.
+            auto window = feather_tk::gl::Window::create(
+                _context,
+                "djv",
+                feather_tk::Size2I(1, 1),
+                static_cast<int>(feather_tk::gl::WindowOptions::MakeCurrent));
+
+            // Open the timeline.
+            tl::file::PathOptions pathOptions;
+            pathOptions.maxNumberDigits = p.settingsModel->getImageSequence().maxDigits;
+            const auto paths = tl::timeline::getPaths(_context, tl::file::Path(inputs.front()), pathOptions);
+            if (paths.empty())
+            {
+                throw std::runtime_error(
+                    feather_tk::Format("Cannot open: \"{0}\"").arg(inputs.front()));
+            }
+            const tl::timeline::Options timelineOptions = getTimelineOptions();
+            auto otioTimeline = p.cmdLine.audioFileName->hasValue() ?
+                tl::timeline::create(
+                    _context,
+                    paths.front(),
+                    tl::file::Path(p.cmdLine.audioFileName->getValue()),
+                    timelineOptions) :
+                tl::timeline::create(_context, paths.front(), timelineOptions);
+            auto timeline = tl::timeline::Timeline::create(_context, otioTimeline, timelineOptions);
+
+            // Get the export options.
+            ExportOptions options;
+            options.settings = settings;
+            const OTIO_NS::TimeRange& timeRange = timeline->getTimeRange();
+            options.range = p.cmdLine.inOutRange->hasValue() ?
+                p.cmdLine.inOutRange->getValue() :
+                timeRange;
+            if (ExportFileType::Image == settings.fileType)
+            {
+                options.range = OTIO_NS::TimeRange(
+                    p.cmdLine.seek->hasValue() ?
+                        p.cmdLine.seek->getValue() :
+                        options.range.start_time(),
+                    OTIO_NS::RationalTime(1.0, timeRange.duration().rate()));
+            }
+            options.speed = p.cmdLine.speed->hasValue() ?
+                p.cmdLine.speed->getValue() :
+                timeRange.duration().rate();
+            options.ocioOptions = p.colorModel->getOCIOOptions();
+            options.lutOptions = p.colorModel->getLUTOptions();
+            options.imageOptions = p.viewportModel->getImageOptions();
+            options.displayOptions = p.viewportModel->getDisplayOptions();
+            options.colorBuffer = p.viewportModel->getColorBuffer();
+            options.prefetch = p.settingsModel->getAdvanced().videoRequestMax;
+
+            // Run the export.
+            auto job = ExportJob::create(_context, timeline, options);
+            const int64_t total = job->getFrameTotal();
+            std::cout << "Export: " << job->getPath().get() << std::endl;
+            const auto t0 = std::chrono::steady_clock::now();
+            int64_t progress = -1;
+            while (job->tick())
+            {
+                _context->tick();
+                const int64_t count = job->getFrameCount();
+                const int64_t percent = total > 0 ? (count * 100 / total) : 100;
+                if (percent / 10 != progress)
+                {
+                    progress = percent / 10;
+                    std::cout << "Frame: " << count << " / " << total <<
+                        " (" << percent << "%)" << std::endl;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            job.reset();
+            const std::chrono::duration<double> diff = std::chrono::steady_clock::now() - t0;
+            std::cout << feather_tk::Format("Exported {0} frames in {1} seconds ({2} FPS)").
+                arg(total).
+                arg(diff.count(), 2).
+                arg(diff.count() > 0.0 ? (total / diff.count()) : 0.0, 2).
+                str() << std::endl;
+        }
 
         std::filesystem::path App::_appDocsPath()
         {
@@ -1020,7 +1548,7 @@ namespace djv
                 str();
         }
 
-        tl::io::Options App::_getIOOptions() const
+        tl::io::Options App::_getIOOptions(int proxyScale) const
         {
             FEATHER_TK_P();
             tl::io::Options out;
@@ -1029,60 +1557,529 @@ namespace djv
             out = tl::io::merge(out, tl::ffmpeg::getOptions(p.settingsModel->getFFmpeg()));
 #endif // TLRENDER_FFMPEG
 #if defined(TLRENDER_USD)
-            out = tl::io::merge(out, tl::usd::getOptions(p.settingsModel->getUSD()));
+            tl::usd::Options usd = p.settingsModel->getUSD();
+            usd.renderWidth = std::max(usd.renderWidth / proxyScale, 1);
+            out = tl::io::merge(out, tl::usd::getOptions(usd));
 #endif // TLRENDER_USD
             return out;
         }
 
-        void App::_filesUpdate(const std::vector<std::shared_ptr<FilesModelItem> >& files)
+        bool App::_timelinesLoad()
         {
             FEATHER_TK_P();
+            bool out = false;
+            const size_t max = std::max(1U, std::thread::hardware_concurrency());
+            auto i = p.timelinesPending.begin();
+            while (i != p.timelinesPending.end() && p.timelinesLoading.size() < max)
+            {
+                const auto item = *i;
 
-            std::vector<std::shared_ptr<tl::timeline::Timeline> > timelines(files.size());
-            for (size_t i = 0; i < files.size(); ++i)
+                // Files with the same media share a timeline, so that the
+                // media is only opened once.
+                std::shared_ptr<FilesModelItem> shared;
+                bool sharedLoading = false;
+                for (size_t j = 0; j < p.files.size(); ++j)
+                {
+                    if (p.files[j] != item &&
+                        p.files[j]->path.get() == item->path.get() &&
+                        p.files[j]->audioPath.get() == item->audioPath.get())
+                    {
+                        if (p.timelines[j])
+                        {
+                            shared = p.files[j];
+                            break;
+                        }
+                        else if (p.timelinesLoading.find(p.files[j]) != p.timelinesLoading.end())
+                        {
+                            sharedLoading = true;
+                        }
+                    }
+                }
+                if (shared)
+                {
+                    i = p.timelinesPending.erase(i);
+                    const auto j = std::find(p.files.begin(), p.files.end(), item);
+                    const auto k = std::find(p.files.begin(), p.files.end(), shared);
+                    if (j != p.files.end() && k != p.files.end())
+                    {
+                        p.timelines[j - p.files.begin()] = p.timelines[k - p.files.begin()];
+                        item->videoLayers = shared->videoLayers;
+                        p.filesModel->setLoading(item, false);
+                        if (std::find(p.activeFiles.begin(), p.activeFiles.end(), item) != p.activeFiles.end())
+                        {
+                            out = true;
+                        }
+                    }
+                }
+                else if (sharedLoading)
+                {
+                    // Wait for the shared timeline to finish loading.
+                    ++i;
+                }
+                else
+                {
+                    i = p.timelinesPending.erase(i);
+                    const tl::file::Path path = item->path;
+                    const tl::file::Path audioPath = item->audioPath;
+                    tl::timeline::Options options = getTimelineOptions();
+                    options.ioOptions = _getIOOptions(p.proxyScale);
+                    std::weak_ptr<feather_tk::Context> contextWeak(_context);
+                    p.timelinesLoading[item] = std::async(
+                        std::launch::async,
+                        [contextWeak, path, audioPath, options]
+                        {
+                            Private::TimelineLoad out;
+                            try
+                            {
+                                if (auto context = contextWeak.lock())
+                                {
+                                    auto otioTimeline = audioPath.isEmpty() ?
+                                        tl::timeline::create(context, path, options) :
+                                        tl::timeline::create(context, path, audioPath, options);
+                                    out.timeline = tl::timeline::Timeline::create(context, otioTimeline, options);
+                                    for (const auto& video : out.timeline->getIOInfo().video)
+                                    {
+                                        out.videoLayers.push_back(video.name);
+                                    }
+                                    out.stamps = getTimelineStamps(out.timeline->getPath(), audioPath);
+                                }
+                            }
+                            catch (const std::exception& e)
+                            {
+                                out.error = e.what();
+                            }
+                            return out;
+                        });
+                }
+            }
+            return out;
+        }
+
+        void App::_timelinesTick()
+        {
+            FEATHER_TK_P();
+            bool active = false;
+            auto i = p.timelinesLoading.begin();
+            while (i != p.timelinesLoading.end())
             {
-                const auto j = std::find(p.files.begin(), p.files.end(), files[i]);
+                if (i->second.valid() &&
+                    i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    const auto item = i->first;
+                    const Private::TimelineLoad load = i->second.get();
+                    i = p.timelinesLoading.erase(i);
+                    if (!load.error.empty())
+                    {
+                        _context->log("djv::app::App", load.error, feather_tk::LogType::Error);
+                    }
+                    const auto j = std::find(p.files.begin(), p.files.end(), item);
+                    if (j != p.files.end())
+                    {
+                        if (p.startupTimeline)
+                        {
+                            p.startupTimeline = false;
+                            _startupTime("First timeline");
+                        }
+                        p.timelines[j - p.files.begin()] = load.timeline;
+                        if (load.timeline)
+                        {
+                            p.timelineStamps[load.timeline] = load.stamps;
+                        }
+                        item->videoLayers = load.videoLayers;
+                        p.filesModel->setLoading(item, false);
+                        const auto k = std::find(p.activeFiles.begin(), p.activeFiles.end(), item);
+                        if (k != p.activeFiles.end())
+                        {
+                            active = true;
+                        }
+                    }
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            if (_timelinesLoad())
+            {
+                active = true;
+            }
+            if (active)
+            {
+                const auto activeFiles = p.activeFiles;
+                _activeUpdate(activeFiles);
+            }
+        }
+
+        void App::_reload(const std::vector<std::shared_ptr<FilesModelItem> >& items)
+        {
+            FEATHER_TK_P();
+            const auto activeFiles = p.activeFiles;
+            const auto files = p.files;
+            std::vector<std::shared_ptr<tl::timeline::Timeline> > timelines;
+            for (const auto& i : items)
+            {
+                const auto j = std::find(p.files.begin(), p.files.end(), i);
                 if (j != p.files.end())
                 {
-                    timelines[i] = p.timelines[j - p.files.begin()];
+                    const size_t index = j - p.files.begin();
+                    timelines.push_back(p.timelines[index]);
+                    p.files.erase(j);
+                    p.timelines.erase(p.timelines.begin() + index);
                 }
             }
 
-            for (size_t i = 0; i < files.size(); ++i)
+            // Reload the other files that share the timelines.
+            for (auto& timeline : p.timelines)
+            {
+                if (timeline && std::find(timelines.begin(), timelines.end(), timeline) != timelines.end())
+                {
+                    timeline.reset();
+                }
+            }
+
+            // The player is kept unless the current file is reloaded. The
+            // current player is then shown until the player for the
+            // reloaded file has cached the current time, so that playback
+            // is not interrupted.
+            if (!activeFiles.empty() &&
+                std::find(items.begin(), items.end(), activeFiles.front()) != items.end())
+            {
+                if (auto player = p.player->get())
+                {
+                    activeFiles.front()->speed = player->getSpeed();
+                    activeFiles.front()->currentTime = player->getCurrentTime();
+                    activeFiles.front()->inOutRange = getInOutRange(player);
+                    p.initLoop = player->getLoop();
+                    p.initPlayback = player->getPlayback();
+                    p.playerReloadItem = activeFiles.front();
+                    p.playerStaged.reset();
+                }
+                else
+                {
+                    p.activeFiles.clear();
+                }
+            }
+
+            _filesUpdate(files);
+            _activeUpdate(activeFiles);
+        }
+
+        void App::_filesChanged(const std::vector<std::string>& directories)
+        {
+            FEATHER_TK_P();
+
+            // Check the files in the changed directories for new or
+            // overwritten frames.
+            std::vector<std::shared_ptr<FilesModelItem> > checks;
+            for (size_t i = 0; i < p.files.size(); ++i)
+            {
+                const auto& item = p.files[i];
+                const auto& timeline = p.timelines[i];
+                if (timeline &&
+                    p.timelineStamps.find(timeline) != p.timelineStamps.end() &&
+                    (std::find(directories.begin(), directories.end(), getDirectory(item->path)) != directories.end() ||
+                        (!item->audioPath.isEmpty() &&
+                            std::find(directories.begin(), directories.end(), getDirectory(item->audioPath)) != directories.end())))
+                {
+                    checks.push_back(item);
+                }
+            }
+            _stampsCheck(checks);
+        }
+
+        void App::_stampsCheck(const std::vector<std::shared_ptr<FilesModelItem> >& items)
+        {
+            FEATHER_TK_P();
+            for (const auto& item : items)
+            {
+                if (std::find(p.stampsPending.begin(), p.stampsPending.end(), item) == p.stampsPending.end())
+                {
+                    p.stampsPending.push_back(item);
+                }
+            }
+        }
+
+        void App::_stampsTick()
+        {
+            FEATHER_TK_P();
+
+            // Image sequences that are growing are not reloaded during
+            // playback until the playback reaches the end, or enough new
+            // frames have been written, since reloading drops the player
+            // cache.
+            bool playing = false;
+            if (auto player = p.player->get())
+            {
+                const OTIO_NS::RationalTime currentTime = player->getCurrentTime();
+                const OTIO_NS::TimeRange& inOutRange = player->getInOutRange();
+                const bool looped = !p.appendTime.strictly_equal(tl::time::invalidTime);
+                const tl::timeline::Playback playback = player->getPlayback();
+                if (tl::timeline::Playback::Forward == playback)
+                {
+                    playing =
+                        currentTime < inOutRange.end_time_inclusive() &&
+                        !(looped && currentTime < p.appendTime);
+                }
+                else if (tl::timeline::Playback::Reverse == playback)
+                {
+                    playing =
+                        currentTime > inOutRange.start_time() &&
+                        !(looped && currentTime > p.appendTime);
+                }
+                p.appendTime = currentTime;
+            }
+            std::vector<std::shared_ptr<FilesModelItem> > items;
+            auto deferred = p.appendDeferred.begin();
+            while (deferred != p.appendDeferred.end())
+            {
+                if (!playing || std::find(p.activeFiles.begin(), p.activeFiles.end(), *deferred) == p.activeFiles.end())
+                {
+                    if (std::find(p.files.begin(), p.files.end(), *deferred) != p.files.end())
+                    {
+                        items.push_back(*deferred);
+                    }
+                    deferred = p.appendDeferred.erase(deferred);
+                }
+                else
+                {
+                    ++deferred;
+                }
+            }
+
+            // Reload the files that have new or overwritten frames.
+            bool thumbnailsChanged = false;
+            if (p.stampsChecking.valid() &&
+                p.stampsChecking.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
             {
-                if (!timelines[i])
+                const std::vector<Private::StampsCheck> checks = p.stampsChecking.get();
+                resetFrameCacheStamps();
+                for (const auto& check : checks)
                 {
-                    try
+                    // Skip the files that were closed or reloaded while
+                    // they were checked.
+                    const auto i = std::find(p.files.begin(), p.files.end(), check.item);
+                    const auto j = p.timelineStamps.find(check.timeline);
+                    if (i != p.files.end() &&
+                        p.timelines[i - p.files.begin()] == check.timeline &&
+                        j != p.timelineStamps.end())
                     {
-                        tl::timeline::Options options;
-                        const ImageSequenceSettings imageSequence = p.settingsModel->getImageSequence();
-                        options.imageSequenceAudio = imageSequence.audio;
-                        options.imageSequenceAudioExtensions = imageSequence.audioExtensions;
-                        options.imageSequenceAudioFileName = imageSequence.audioFileName;
-                        const AdvancedSettings advanced = p.settingsModel->getAdvanced();
-                        options.compat = advanced.compat;
-                        options.videoRequestMax = advanced.videoRequestMax;
-                        options.audioRequestMax = advanced.audioRequestMax;
-                        options.ioOptions = _getIOOptions();
-                        options.pathOptions.maxNumberDigits = imageSequence.maxDigits;
-                        auto otioTimeline = files[i]->audioPath.isEmpty() ?
-                            tl::timeline::create(_context, files[i]->path, options) :
-                            tl::timeline::create(_context, files[i]->path, files[i]->audioPath, options);
-                        timelines[i] = tl::timeline::Timeline::create(_context, otioTimeline, options);
-                        for (const auto& video : timelines[i]->getIOInfo().video)
+                        bool changed = false;
+                        if (compareStamps(j->second, check.stamps, p.frameCacheModel))
+                        {
+                            // Only the active files are shown in the
+                            // timeline, the thumbnails of the other files
+                            // are removed when they become active.
+                            changed = true;
+                            if (std::find(p.activeFiles.begin(), p.activeFiles.end(), check.item) != p.activeFiles.end())
+                            {
+                                thumbnailsChanged = true;
+                            }
+                            else if (std::find(p.thumbnailsStale.begin(), p.thumbnailsStale.end(), check.item) == p.thumbnailsStale.end())
+                            {
+                                p.thumbnailsStale.push_back(check.item);
+                            }
+                        }
+                        if (!changed && check.appendedFrames > 0)
                         {
-                            files[i]->videoLayers.push_back(video.name);
+                            if (playing &&
+                                check.appendedFrames < appendFramesMax &&
+                                std::find(p.activeFiles.begin(), p.activeFiles.end(), check.item) != p.activeFiles.end())
+                            {
+                                if (std::find(p.appendDeferred.begin(), p.appendDeferred.end(), check.item) == p.appendDeferred.end())
+                                {
+                                    p.appendDeferred.push_back(check.item);
+                                }
+                            }
+                            else
+                            {
+                                changed = true;
+                            }
+                        }
+                        if (changed && std::find(items.begin(), items.end(), check.item) == items.end())
+                        {
+                            items.push_back(check.item);
                         }
                     }
-                    catch (const std::exception& e)
+                }
+            }
+            if (!items.empty())
+            {
+                for (const auto& item : items)
+                {
+                    const auto j = std::find(p.appendDeferred.begin(), p.appendDeferred.end(), item);
+                    if (j != p.appendDeferred.end())
                     {
-                        _context->log("djv::app::App", e.what(), feather_tk::LogType::Error);
+                        p.appendDeferred.erase(j);
                     }
                 }
+                if (thumbnailsChanged)
+                {
+                    // The timeline thumbnails cannot be removed individually.
+                    auto thumbnailSystem = _context->getSystem<tl::timelineui::ThumbnailSystem>();
+                    thumbnailSystem->getCache()->clear();
+                }
+                _reload(items);
             }
 
+            // Start checking the pending files. The file system is queried
+            // on a thread, since image sequences have a file for each frame.
+            if (!p.stampsChecking.valid() && !p.stampsPending.empty())
+            {
+                std::vector<Private::StampsCheck> checks;
+                for (const auto& item : p.stampsPending)
+                {
+                    const auto i = std::find(p.files.begin(), p.files.end(), item);
+                    if (i != p.files.end())
+                    {
+                        if (auto timeline = p.timelines[i - p.files.begin()])
+                        {
+                            Private::StampsCheck check;
+                            check.item = item;
+                            check.timeline = timeline;
+                            check.audioPath = item->audioPath;
+                            checks.push_back(check);
+                        }
+                    }
+                }
+                p.stampsPending.clear();
+                p.stampsChecking = std::async(
+                    std::launch::async,
+                    [checks]() mutable
+                    {
+                        for (auto& check : checks)
+                        {
+                            const tl::file::Path& path = check.timeline->getPath();
+                            check.stamps = getTimelineStamps(path, check.audioPath);
+
+                            // Count the frames added to the end of image sequences.
+                            if (path.isSequence())
+                            {
+                                const int64_t end = static_cast<int64_t>(
+                                    check.timeline->getTimeRange().end_time_exclusive().value());
+                                bool exists = true;
+                                while (exists && check.appendedFrames < appendFramesMax)
+                                {
+                                    const std::string next = path.get(static_cast<int>(end + check.appendedFrames));
+                                    std::error_code ec;
+                                    exists = std::filesystem::exists(std::filesystem::u8path(next), ec);
+                                    if (exists)
+                                    {
+                                        ++check.appendedFrames;
+                                    }
+                                }
+                            }
+                        }
+                        return checks;
+                    });
+            }
+        }
+
+        void App::_ioOptionsUpdate()
+        {
+            FEATHER_TK_P();
+
+            // The I/O options are set when the timelines are created, so
+            // the USD files are reloaded when the proxy changes. The cached
+            // frames are kept since the cache keys include the I/O options.
+            const int proxyScale = getProxyScale(p.viewportModel->getProxyOptions());
+            if (proxyScale != p.proxyScale)
+            {
+                p.proxyScale = proxyScale;
+#if defined(TLRENDER_USD)
+                std::vector<std::shared_ptr<FilesModelItem> > items;
+                for (const auto& item : p.files)
+                {
+                    if (isUSD(item->path))
+                    {
+                        items.push_back(item);
+                    }
+                }
+                if (!items.empty())
+                {
+                    _reload(items);
+                }
+#endif // TLRENDER_USD
+            }
+        }
+
+        void App::_filesUpdate(const std::vector<std::shared_ptr<FilesModelItem> >& files)
+        {
+            FEATHER_TK_P();
+
+            std::vector<std::shared_ptr<tl::timeline::Timeline> > timelines(files.size());
+            for (size_t i = 0; i < files.size(); ++i)
+            {
+                const auto j = std::find(p.files.begin(), p.files.end(), files[i]);
+                if (j != p.files.end())
+                {
+                    timelines[i] = p.timelines[j - p.files.begin()];
+                }
+            }
             p.files = files;
             p.timelines = timelines;
+
+            // Watch the directories of the files for changes.
+            std::vector<std::string> directories;
+            for (const auto& item : files)
+            {
+                for (const auto& path : { item->path, item->audioPath })
+                {
+                    const std::string directory = !path.isEmpty() ? getDirectory(path) : std::string();
+                    if (!directory.empty() &&
+                        std::find(directories.begin(), directories.end(), directory) == directories.end())
+                    {
+                        directories.push_back(directory);
+                    }
+                }
+            }
+            p.fileWatcherModel->setDirectories(directories);
+
+            // Remove the stamps for timelines that are no longer used.
+            auto stamps = p.timelineStamps.begin();
+            while (stamps != p.timelineStamps.end())
+            {
+                if (std::find(timelines.begin(), timelines.end(), stamps->first) == timelines.end())
+                {
+                    stamps = p.timelineStamps.erase(stamps);
+                }
+                else
+                {
+                    ++stamps;
+                }
+            }
+
+            // Remove pooled players for files that have been closed.
+            p.playerPool.remove_if(
+                [files](const std::pair<std::shared_ptr<FilesModelItem>, std::shared_ptr<tl::timeline::Player> >& value)
+                {
+                    return std::find(files.begin(), files.end(), value.first) == files.end();
+                });
+            _cacheUpdate();
+
+            // Remove pending timelines for files that have been closed.
+            p.timelinesPending.remove_if(
+                [files](const std::shared_ptr<FilesModelItem>& item)
+                {
+                    return std::find(files.begin(), files.end(), item) == files.end();
+                });
+
+            // Timelines are created on worker threads, the files are marked
+            // as loading until they are finished.
+            for (size_t i = 0; i < files.size(); ++i)
+            {
+                if (!timelines[i] &&
+                    std::find(p.timelinesPending.begin(), p.timelinesPending.end(), files[i]) == p.timelinesPending.end() &&
+                    p.timelinesLoading.find(files[i]) == p.timelinesLoading.end())
+                {
+                    p.timelinesPending.push_back(files[i]);
+                    p.filesModel->setLoading(files[i], true);
+                }
+            }
+            if (_timelinesLoad())
+            {
+                const auto activeFiles = p.activeFiles;
+                _activeUpdate(activeFiles);
+            }
         }
 
         void App::_activeUpdate(const std::vector<std::shared_ptr<FilesModelItem> >& activeFiles)
@@ -1095,38 +2092,84 @@ namespace djv
                 {
                     p.activeFiles.front()->speed = player->getSpeed();
                     p.activeFiles.front()->currentTime = player->getCurrentTime();
-                    p.activeFiles.front()->inOutRange = player->getInOutRange();
+                    p.activeFiles.front()->inOutRange = getInOutRange(player);
                 }
             }
 
             std::shared_ptr<tl::timeline::Player> player;
             if (!activeFiles.empty())
             {
-                if (!p.activeFiles.empty() && activeFiles[0] == p.activeFiles[0])
+                if (p.playerStaged && activeFiles[0] == p.playerReloadItem)
+                {
+                    player = p.playerStaged;
+                }
+                else if (!p.playerReloadItem &&
+                    !p.activeFiles.empty() &&
+                    activeFiles[0] == p.activeFiles[0] &&
+                    p.player->get())
                 {
                     player = p.player->get();
                 }
                 else
                 {
-                    if (auto player = p.player->get())
+                    // Move the current player to the pool so that its
+                    // cache is kept. The player of a reloaded file is not
+                    // kept since its timeline is out of date.
+                    auto player = p.player->get();
+                    if (player && !p.playerReloadItem)
                     {
                         player->setAudioDevice(tl::audio::DeviceID());
+                        if (!p.activeFiles.empty())
+                        {
+                            player->setPlayback(tl::timeline::Playback::Stop);
+                            player->setCompare({});
+                            p.playerPool.push_front(std::make_pair(p.activeFiles.front(), player));
+                        }
                     }
                     auto i = std::find(p.files.begin(), p.files.end(), activeFiles[0]);
                     if (i != p.files.end())
                     {
-                        if (auto timeline = p.timelines[i - p.files.begin()])
+                        auto timeline = p.timelines[i - p.files.begin()];
+                        const auto j = std::find_if(
+                            p.playerPool.begin(),
+                            p.playerPool.end(),
+                            [activeFiles](const std::pair<std::shared_ptr<FilesModelItem>, std::shared_ptr<tl::timeline::Player> >& value)
+                            {
+                                return value.first == activeFiles[0];
+                            });
+                        if (j != p.playerPool.end())
+                        {
+                            // The pooled player is discarded if the file
+                            // has been reloaded.
+                            if (timeline && j->second->getTimeline() == timeline)
+                            {
+                                player = j->second;
+                                player->setAudioDevice(p.audioModel->getDevice());
+                            }
+                            p.playerPool.erase(j);
+                        }
+                        if (timeline && !player)
                         {
                             try
                             {
                                 tl::timeline::PlayerOptions playerOptions;
                                 playerOptions.audioDevice = p.audioModel->getDevice();
-                                playerOptions.cache = p.settingsModel->getCache();
+                                playerOptions.cache = p.cacheModel->getCacheOptions();
                                 const AdvancedSettings advanced = p.settingsModel->getAdvanced();
                                 playerOptions.videoRequestMax = advanced.videoRequestMax;
                                 playerOptions.audioRequestMax = advanced.audioRequestMax;
                                 playerOptions.audioBufferFrameCount = advanced.audioBufferFrameCount;
                                 player = tl::timeline::Player::create(_context, timeline, playerOptions);
+                                if (p.initLoop.has_value())
+                                {
+                                    player->setLoop(p.initLoop.value());
+                                    p.initLoop.reset();
+                                }
+                                if (p.initPlayback.has_value())
+                                {
+                                    player->setPlayback(p.initPlayback.value());
+                                    p.initPlayback.reset();
+                                }
                             }
                             catch (const std::exception& e)
                             {
@@ -1134,6 +2177,7 @@ namespace djv
                             }
                         }
                     }
+                    _playerPoolUpdate();
                 }
             }
             if (player)
@@ -1159,16 +2203,82 @@ namespace djv
                     auto j = std::find(p.files.begin(), p.files.end(), activeFiles[i]);
                     if (j != p.files.end())
                     {
+                        // Files that are still loading are added when
+                        // their timelines are finished.
                         auto timeline = p.timelines[j - p.files.begin()];
-                        compare.push_back(timeline);
+                        if (timeline)
+                        {
+                            compare.push_back(timeline);
+                        }
                     }
                 }
                 player->setCompare(compare);
                 player->setCompareTime(p.filesModel->getCompareTime());
             }
 
+            // Keep the player for the reloaded file in the background, see
+            // _playerStagedTick().
+            if (p.playerReloadItem)
+            {
+                if (!activeFiles.empty() && activeFiles.front() == p.playerReloadItem && p.player->get())
+                {
+                    p.playerStaged = player;
+                    if (player)
+                    {
+                        player->setAudioDevice(tl::audio::DeviceID());
+                        player->setPlayback(tl::timeline::Playback::Stop);
+                    }
+                    player = p.player->get();
+                }
+                else
+                {
+                    p.playerReloadItem.reset();
+                    p.playerStaged.reset();
+                }
+            }
+
+            // Remove the timeline thumbnails of the files that were
+            // overwritten while they were not active.
+            bool thumbnailsChanged = false;
+            auto stale = p.thumbnailsStale.begin();
+            while (stale != p.thumbnailsStale.end())
+            {
+                const bool active = std::find(activeFiles.begin(), activeFiles.end(), *stale) != activeFiles.end();
+                if (active || std::find(p.files.begin(), p.files.end(), *stale) == p.files.end())
+                {
+                    thumbnailsChanged |= active;
+                    stale = p.thumbnailsStale.erase(stale);
+                }
+                else
+                {
+                    ++stale;
+                }
+            }
+            if (thumbnailsChanged)
+            {
+                auto thumbnailSystem = _context->getSystem<tl::timelineui::ThumbnailSystem>();
+                thumbnailSystem->getCache()->clear();
+            }
+
             p.activeFiles = activeFiles;
             p.player->setIfChanged(player);
+            p.readAheadModel->setPlayer(player);
+            p.thumbnailScheduler->setPlayer(player);
+            _cacheUpdate();
+            p.cacheInfoObserver.reset();
+            if (player)
+            {
+                p.cacheInfoObserver = feather_tk::ValueObserver<tl::timeline::PlayerCacheInfo>::create(
+                    player->observeCacheInfo(),
+                    [this](const tl::timeline::PlayerCacheInfo& value)
+                    {
+                        // Assume the pooled players have filled their
+                        // share of the cache.
+                        _p->cacheModel->setCacheUsage(
+                            value.videoPercentage / 100.F * _p->playerVideoGB +
+                            _p->playerPoolVideoGB);
+                    });
+            }
 #if defined(TLRENDER_BMD)
             p.bmdOutputDevice->setPlayer(player);
 #endif // TLRENDER_BMD
@@ -1177,6 +2287,97 @@ namespace djv
             _audioUpdate();
         }
 
+        void App::_playerStagedTick()
+        {
+            FEATHER_TK_P();
+            auto player = p.player->get();
+            if (p.playerStaged && player)
+            {
+                // Follow the current time of the current player, and switch
+                // to the player for the reloaded file when it has cached the
+                // current time.
+                p.playerStaged->tick();
+                const OTIO_NS::RationalTime currentTime = player->getCurrentTime();
+                if (!p.playerStaged->getCurrentTime().strictly_equal(currentTime))
+                {
+                    p.playerStaged->seek(currentTime);
+                }
+                bool cached = !p.playerStaged->getTimeRange().contains(currentTime);
+                for (const auto& timeRange : p.playerStaged->observeCacheInfo()->get().video)
+                {
+                    cached |= timeRange.contains(currentTime);
+                }
+                if (cached)
+                {
+                    auto playerStaged = p.playerStaged;
+                    playerStaged->setLoop(player->getLoop());
+                    playerStaged->setPlayback(player->getPlayback());
+                    playerStaged->setAudioDevice(p.audioModel->getDevice());
+                    p.playerReloadItem.reset();
+                    p.playerStaged.reset();
+                    p.player->setIfChanged(playerStaged);
+                    const auto activeFiles = p.activeFiles;
+                    _activeUpdate(activeFiles);
+                }
+            }
+        }
+
+        void App::_playerPoolUpdate()
+        {
+            FEATHER_TK_P();
+            const size_t count = p.settingsModel->getPlayerPool().count;
+            while (p.playerPool.size() > count)
+            {
+                p.playerPool.pop_back();
+            }
+            _cacheUpdate();
+        }
+
+        void App::_cacheUpdate()
+        {
+            FEATHER_TK_P();
+
+            // The players share the cache budget. Each pooled player is
+            // given an equal part of the pool percentage and the current
+            // player is given the remainder.
+            tl::timeline::PlayerCacheOptions options = p.cacheModel->getCacheOptions();
+            const PlayerPoolSettings& pool = p.settingsModel->getPlayerPool();
+            tl::timeline::PlayerCacheOptions poolOptions = options;
+            if (pool.count > 0)
+            {
+                const float share = pool.percentage / 100.F / pool.count;
+                poolOptions.videoGB = options.videoGB * share;
+                poolOptions.audioGB = options.audioGB * share;
+            }
+            tl::timeline::PlayerCacheOptions playerOptions = options;
+            playerOptions.videoGB = std::max(
+                options.videoGB - poolOptions.videoGB * p.playerPool.size(),
+                0.F);
+            playerOptions.audioGB = std::max(
+                options.audioGB - poolOptions.audioGB * p.playerPool.size(),
+                0.F);
+
+            // The read behind of the current player follows the playback
+            // speed and loop mode.
+            p.readAheadModel->setVideoGB(playerOptions.videoGB);
+            playerOptions.readBehind = p.readAheadModel->getReadBehind();
+
+            if (auto player = p.player->get())
+            {
+                player->setCacheOptions(playerOptions);
+            }
+            if (p.playerStaged)
+            {
+                p.playerStaged->setCacheOptions(playerOptions);
+            }
+            for (const auto& i : p.playerPool)
+            {
+                i.second->setCacheOptions(poolOptions);
+            }
+            p.playerVideoGB = playerOptions.videoGB;
+            p.playerPoolVideoGB = poolOptions.videoGB * p.playerPool.size();
+        }
+
         void App::_layersUpdate(const std::vector<int>& value)
         {
             FEATHER_TK_P();
@@ -33,14 +33,22 @@ namespace djv
         struct FilesModelItem;
 
         class AudioModel;
+        class CacheModel;
         class ColorModel;
+        class ExportQueue;
+        class FileWatcherModel;
         class FilesModel;
+        class FrameCacheModel;
+        class FrameTimingModel;
         class MainWindow;
         class RecentFilesModel;
         class SettingsModel;
+        class ThumbnailCacheModel;
+        class ThumbnailScheduler;
         class TimeUnitsModel;
         class ToolsModel;
         class ViewportModel;
+        class WaveformModel;
 #if defined(TLRENDER_BMD)
         class BMDDevicesModel;
 #endif // TLRENDER_BMD
@@ -82,6 +90,9 @@ namespace djv
             //! Get the settings model.
             const std::shared_ptr<SettingsModel>& getSettingsModel() const;
 
+            //! Get the cache model.
+            const std::shared_ptr<CacheModel>& getCacheModel() const;
+
             //! Get the time units model.
             const std::shared_ptr<TimeUnitsModel>& getTimeUnitsModel() const;
 
@@ -91,7 +102,15 @@ namespace djv
             //! Get the recent files model.
             const std::shared_ptr<RecentFilesModel>& getRecentFilesModel() const;
 
-            //! Reload the active files.
+            //! Get the timeline options. The options are full resolution,
+            //! the USD proxy is only used for the timelines in the viewer.
+            tl::timeline::Options getTimelineOptions() const;
+
+            //! Reload the active files that have changed. Image sequences
+            //! are compared frame by frame, and only the frames that have
+            //! changed are removed from the frame cache. The files are
+            //! compared on a thread, and reloaded when the comparison is
+            //! finished.
             void reload();
 
             //! Observe the timeline player.
@@ -109,6 +128,27 @@ namespace djv
             //! Get the tools model.
             const std::shared_ptr<ToolsModel>& getToolsModel() const;
 
+            //! Get the export queue.
+            const std::shared_ptr<ExportQueue>& getExportQueue() const;
+
+            //! Get the frame cache model.
+            const std::shared_ptr<FrameCacheModel>& getFrameCacheModel() const;
+
+            //! Get the thumbnail cache model.
+            const std::shared_ptr<ThumbnailCacheModel>& getThumbnailCacheModel() const;
+
+            //! Get the thumbnail scheduler.
+            const std::shared_ptr<ThumbnailScheduler>& getThumbnailScheduler() const;
+
+            //! Get the waveform model.
+            const std::shared_ptr<WaveformModel>& getWaveformModel() const;
+
+            //! Get the frame timing model.
+            const std::shared_ptr<FrameTimingModel>& getFrameTimingModel() const;
+
+            //! Write the frame timing as a Chrome trace JSON file.
+            void writeFrameTiming();
+
             //! Get the main window.
             const std::shared_ptr<MainWindow>& getMainWindow() const;
 
@@ -137,6 +177,8 @@ namespace djv
             void _observersInit();
             void _inputFilesInit();
             void _windowsInit();
+            void _exportRun();
+            void _startupTime(const std::string&);
 
             std::filesystem::path _appDocsPath();
             std::filesystem::path _getLogFilePath(
@@ -145,10 +187,21 @@ namespace djv
             std::filesystem::path _getSettingsPath(
                 const std::string& appName,
                 const std::filesystem::path& appDocsPath);
-            tl::io::Options _getIOOptions() const;
+            tl::io::Options _getIOOptions(int proxyScale) const;
+
+            bool _timelinesLoad();
+            void _timelinesTick();
 
+            void _reload(const std::vector<std::shared_ptr<FilesModelItem> >&);
+            void _ioOptionsUpdate();
             void _filesUpdate(const std::vector<std::shared_ptr<FilesModelItem> >&);
+            void _filesChanged(const std::vector<std::string>& directories);
+            void _stampsCheck(const std::vector<std::shared_ptr<FilesModelItem> >&);
+            void _stampsTick();
             void _activeUpdate(const std::vector<std::shared_ptr<FilesModelItem> >&);
+            void _playerStagedTick();
+            void _playerPoolUpdate();
+            void _cacheUpdate();
             void _layersUpdate(const std::vector<int>&);
             void _viewUpdate(const feather_tk::V2I& pos, double zoom, bool frame);
             void _audioUpdate();
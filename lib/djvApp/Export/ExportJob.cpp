@@ -0,0 +1,683 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Export/ExportJob.h>
+
+#include <djvApp/Models/FrameCacheModel.h>
+
+#include <tlTimelineGL/Render.h>
+
+#include <tlIO/System.h>
+
+#include <feather-tk/gl/GL.h>
+#include <feather-tk/gl/OffscreenBuffer.h>
+#include <feather-tk/gl/Util.h>
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/Format.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <iomanip>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            std::shared_ptr<feather_tk::Image> flipY(const std::shared_ptr<feather_tk::Image>& image)
+            {
+                feather_tk::ImageInfo info = image->getInfo();
+                info.layout.mirror.y = !info.layout.mirror.y;
+                auto out = feather_tk::Image::create(info);
+                const size_t scanlineByteCount = image->getByteCount() / info.size.h;
+                for (int y = 0; y < info.size.h; ++y)
+                {
+                    memcpy(
+                        out->getData() + y * scanlineByteCount,
+                        image->getData() + (info.size.h - 1 - y) * scanlineByteCount,
+                        scanlineByteCount);
+                }
+                return out;
+            }
+        }
+
+        bool ExportOptions::operator == (const ExportOptions& other) const
+        {
+            return
+                settings == other.settings &&
+                range == other.range &&
+                speed == other.speed &&
+                videoLayer == other.videoLayer &&
+                ocioOptions == other.ocioOptions &&
+                lutOptions == other.lutOptions &&
+                imageOptions == other.imageOptions &&
+                displayOptions == other.displayOptions &&
+                colorBuffer == other.colorBuffer &&
+                prefetch == other.prefetch &&
+                sequenceThreads == other.sequenceThreads &&
+                writeMax == other.writeMax;
+        }
+
+        bool ExportOptions::operator != (const ExportOptions& other) const
+        {
+            return !(*this == other);
+        }
+
+        struct ExportJob::Private
+        {
+            std::weak_ptr<feather_tk::Context> context;
+            ExportOptions options;
+            std::shared_ptr<tl::timeline::Timeline> timeline;
+            std::shared_ptr<FrameCacheModel> frameCache;
+            tl::io::Options ioOptions;
+            tl::file::Path path;
+            feather_tk::ImageInfo info;
+            std::vector<std::shared_ptr<tl::io::IWrite> > writers;
+            size_t writeMax = 0;
+            std::shared_ptr<tl::timeline::IRender> render;
+            std::shared_ptr<feather_tk::gl::OffscreenBuffer> buffer;
+            GLenum glFormat = 0;
+            GLenum glType = 0;
+            bool passThrough = false;
+
+            struct Request
+            {
+                int64_t frame = 0;
+                std::string key;
+                tl::timeline::VideoRequest request;
+                std::optional<tl::timeline::VideoData> video;
+            };
+            int64_t requestFrame = 0;
+            std::list<Request> requests;
+
+            struct Readback
+            {
+                int64_t frame = 0;
+                GLuint pbo = 0;
+            };
+            GLuint pbo[2] = { 0, 0 };
+            size_t pboIndex = 0;
+            std::list<Readback> readbacks;
+
+            struct Mutex
+            {
+                std::list<std::pair<int64_t, std::shared_ptr<feather_tk::Image> > > queue;
+                int64_t written = 0;
+                std::string error;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+            std::condition_variable cv;
+            std::vector<std::thread> threads;
+            std::atomic<bool> running;
+        };
+
+        void ExportJob::_init(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<tl::timeline::Timeline>& timeline,
+            const ExportOptions& options,
+            const std::shared_ptr<FrameCacheModel>& frameCache)
+        {
+            FEATHER_TK_P();
+
+            const tl::io::Info ioInfo = timeline->getIOInfo();
+            if (ioInfo.video.empty())
+            {
+                throw std::runtime_error("No video to render");
+            }
+            p.context = context;
+            p.options = options;
+            p.timeline = timeline;
+            p.frameCache = frameCache;
+            if (p.options.speed <= 0.0)
+            {
+                p.options.speed = timeline->getTimeRange().duration().rate();
+            }
+            p.ioOptions = timeline->getOptions().ioOptions;
+            p.ioOptions["Layer"] = feather_tk::Format("{0}").arg(p.options.videoLayer);
+            p.requestFrame = p.options.range.start_time().value();
+
+            // Get the render size.
+            switch (p.options.settings.renderSize)
+            {
+            case ExportRenderSize::Default:
+                p.info.size = ioInfo.video.front().size;
+                break;
+            case ExportRenderSize::Custom:
+                p.info.size = p.options.settings.customSize;
+                break;
+            default:
+                p.info.size = getSize(p.options.settings.renderSize);
+                break;
+            }
+
+            // Get the export path.
+            const std::string fileName = getExportFileName(
+                p.options.settings,
+                p.options.range.start_time().value());
+            p.path = tl::file::Path((std::filesystem::u8path(p.options.settings.directory) /
+                std::filesystem::u8path(fileName)).u8string());
+
+            // Get the writer.
+            auto ioSystem = context->getSystem<tl::io::WriteSystem>();
+            auto plugin = ioSystem->getPlugin(p.path);
+            if (!plugin)
+            {
+                throw std::runtime_error(
+                    feather_tk::Format("Cannot open: \"{0}\"").arg(p.path.get()));
+            }
+            p.info.type = ioInfo.video.front().type;
+            p.info = plugin->getInfo(p.info);
+            if (feather_tk::ImageType::None == p.info.type)
+            {
+                p.info.type = feather_tk::ImageType::RGBA_U8;
+            }
+            tl::io::Info outputInfo;
+            outputInfo.video.push_back(p.info);
+            outputInfo.videoTime = OTIO_NS::TimeRange(
+                OTIO_NS::RationalTime(0.0, p.options.speed),
+                p.options.range.duration().rescaled_to(p.options.speed));
+            tl::io::Options ioOptions;
+            ioOptions["FFmpeg/Codec"] = p.options.settings.movieCodec;
+
+            // Image sequences are written in parallel, with a separate writer
+            // for each thread since every frame is a separate file.
+            size_t writerCount = 1;
+            if (ExportFileType::Sequence == p.options.settings.fileType)
+            {
+                writerCount = p.options.sequenceThreads > 0 ?
+                    p.options.sequenceThreads :
+                    std::max(std::thread::hardware_concurrency(), 1U);
+                writerCount = std::min(
+                    writerCount,
+                    static_cast<size_t>(std::max(p.options.range.duration().value(), 1.0)));
+            }
+            for (size_t i = 0; i < writerCount; ++i)
+            {
+                p.writers.push_back(plugin->write(p.path, outputInfo, ioOptions));
+            }
+            p.writeMax = p.options.writeMax > 0 ?
+                p.options.writeMax :
+                std::max(writerCount * 2, static_cast<size_t>(4));
+
+            // Check whether the decoded images can be written directly,
+            // without being rendered.
+            p.passThrough = isPassThrough(p.options);
+            if (!p.passThrough)
+            {
+                _renderInit();
+            }
+
+            // Start the writer threads.
+            p.running = true;
+            for (const auto& writer : p.writers)
+            {
+                p.threads.push_back(std::thread(
+                    [this, writer]
+                    {
+                        FEATHER_TK_P();
+                        const int64_t start = p.options.range.start_time().value();
+                        while (p.running)
+                        {
+                            int64_t frame = 0;
+                            std::shared_ptr<feather_tk::Image> image;
+                            {
+                                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                                p.cv.wait(
+                                    lock,
+                                    [this]
+                                    {
+                                        return !_p->mutex.queue.empty() || !_p->running;
+                                    });
+                                if (p.running)
+                                {
+                                    frame = p.mutex.queue.front().first;
+                                    image = p.mutex.queue.front().second;
+                                    p.mutex.queue.pop_front();
+                                }
+                            }
+                            if (image)
+                            {
+                                try
+                                {
+                                    writer->writeVideo(
+                                        OTIO_NS::RationalTime(frame - start, p.options.speed),
+                                        image);
+                                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                                    ++p.mutex.written;
+                                }
+                                catch (const std::exception& e)
+                                {
+                                    {
+                                        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                                        p.mutex.error = e.what();
+                                        p.running = false;
+                                    }
+                                    p.cv.notify_all();
+                                }
+                            }
+                        }
+                    }));
+            }
+        }
+
+        ExportJob::ExportJob() :
+            _p(new Private)
+        {}
+
+        ExportJob::~ExportJob()
+        {
+            FEATHER_TK_P();
+            cancel();
+            for (auto& thread : p.threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+#if defined(FEATHER_TK_API_GL_4_1)
+            if (p.pbo[0] || p.pbo[1])
+            {
+                glDeleteBuffers(2, p.pbo);
+            }
+#endif // FEATHER_TK_API_GL_4_1
+        }
+
+        std::shared_ptr<ExportJob> ExportJob::create(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<tl::timeline::Timeline>& timeline,
+            const ExportOptions& options,
+            const std::shared_ptr<FrameCacheModel>& frameCache)
+        {
+            auto out = std::shared_ptr<ExportJob>(new ExportJob);
+            out->_init(context, timeline, options, frameCache);
+            return out;
+        }
+
+        const tl::file::Path& ExportJob::getPath() const
+        {
+            return _p->path;
+        }
+
+        const OTIO_NS::TimeRange& ExportJob::getRange() const
+        {
+            return _p->options.range;
+        }
+
+        int64_t ExportJob::getFrameCount() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex.mutex);
+            return _p->mutex.written;
+        }
+
+        int64_t ExportJob::getFrameTotal() const
+        {
+            return static_cast<int64_t>(_p->options.range.duration().value());
+        }
+
+        bool ExportJob::tick()
+        {
+            FEATHER_TK_P();
+
+            // Check the writer thread.
+            size_t writeQueueSize = 0;
+            int64_t written = 0;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (!p.mutex.error.empty())
+                {
+                    throw std::runtime_error(p.mutex.error);
+                }
+                writeQueueSize = p.mutex.queue.size();
+                written = p.mutex.written;
+            }
+            const bool out = written < getFrameTotal();
+            if (out)
+            {
+                // Request video ahead of the render.
+                const double rate = p.options.range.duration().rate();
+                const int64_t end = p.options.range.end_time_inclusive().value();
+                while (p.requests.size() < std::max(p.options.prefetch, static_cast<size_t>(1)) &&
+                    p.requestFrame <= end)
+                {
+                    const OTIO_NS::RationalTime t(p.requestFrame, rate);
+                    Private::Request request;
+                    request.frame = p.requestFrame;
+                    tl::timeline::VideoData video;
+                    if (p.frameCache)
+                    {
+                        request.key = getFrameCacheKey(
+                            p.timeline->getPath(),
+                            p.options.videoLayer,
+                            t,
+                            p.timeline->getOptions().ioOptions);
+                        if (p.frameCache->get(request.key, video))
+                        {
+                            request.video = video;
+                        }
+                    }
+                    if (!request.video.has_value())
+                    {
+                        request.request = p.timeline->getVideo(t, p.ioOptions);
+                    }
+                    p.requests.push_back(std::move(request));
+                    ++p.requestFrame;
+                }
+
+                // Render the video that is ready, in order. The render is
+                // throttled when the writer thread falls behind.
+                while (!p.requests.empty() &&
+                    writeQueueSize + p.readbacks.size() < p.writeMax &&
+                    (p.requests.front().video.has_value() ||
+                    (p.requests.front().request.future.valid() &&
+                    p.requests.front().request.future.wait_for(std::chrono::seconds(0)) ==
+                    std::future_status::ready)))
+                {
+                    auto& request = p.requests.front();
+                    const int64_t frame = request.frame;
+                    tl::timeline::VideoData video;
+                    if (request.video.has_value())
+                    {
+                        video = request.video.value();
+                    }
+                    else
+                    {
+                        video = request.request.future.get();
+                        if (p.frameCache)
+                        {
+                            p.frameCache->add(request.key, video);
+                        }
+                    }
+                    p.requests.pop_front();
+                    std::shared_ptr<feather_tk::Image> image;
+                    if (p.passThrough)
+                    {
+                        image = _getPassThrough(video);
+                    }
+                    if (image)
+                    {
+                        // Keep the frames in order for the movie writers.
+                        while (!p.readbacks.empty())
+                        {
+                            _readback();
+                        }
+                        _write(frame, image);
+                    }
+                    else
+                    {
+                        _render(frame, video);
+                    }
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    writeQueueSize = p.mutex.queue.size();
+                }
+
+                // Flush the remaining read backs.
+                if (p.requests.empty() && p.requestFrame > end)
+                {
+                    while (!p.readbacks.empty())
+                    {
+                        _readback();
+                    }
+                }
+            }
+            return out;
+        }
+
+        void ExportJob::cancel()
+        {
+            FEATHER_TK_P();
+            std::vector<uint64_t> ids;
+            for (const auto& request : p.requests)
+            {
+                if (!request.video.has_value())
+                {
+                    ids.push_back(request.request.id);
+                }
+            }
+            p.requests.clear();
+            if (p.timeline && !ids.empty())
+            {
+                p.timeline->cancelRequests(ids);
+            }
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.running = false;
+                p.mutex.queue.clear();
+            }
+            p.cv.notify_all();
+        }
+
+        void ExportJob::_renderInit()
+        {
+            FEATHER_TK_P();
+            if (auto context = p.context.lock())
+            {
+                p.glFormat = feather_tk::gl::getReadPixelsFormat(p.info.type);
+                p.glType = feather_tk::gl::getReadPixelsType(p.info.type);
+                if (GL_NONE == p.glFormat || GL_NONE == p.glType)
+                {
+                    throw std::runtime_error(
+                        feather_tk::Format("Cannot render: \"{0}\"").arg(p.path.get()));
+                }
+
+                // Create the renderer.
+                p.render = tl::timeline_gl::Render::create(context);
+                feather_tk::gl::OffscreenBufferOptions offscreenBufferOptions;
+                offscreenBufferOptions.color = p.options.colorBuffer;
+                p.buffer = feather_tk::gl::OffscreenBuffer::create(
+                    p.info.size,
+                    offscreenBufferOptions);
+
+                // Create the pixel buffer objects used for reading back the
+                // render. Two buffers are used so that the read back of one
+                // frame overlaps with the render of the next.
+#if defined(FEATHER_TK_API_GL_4_1)
+                glGenBuffers(2, p.pbo);
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, p.pbo[i]);
+                    glBufferData(
+                        GL_PIXEL_PACK_BUFFER,
+                        p.info.getByteCount(),
+                        NULL,
+                        GL_STREAM_READ);
+                }
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif // FEATHER_TK_API_GL_4_1
+            }
+        }
+
+        std::shared_ptr<feather_tk::Image> ExportJob::_getPassThrough(const tl::timeline::VideoData& video)
+        {
+            FEATHER_TK_P();
+            std::shared_ptr<feather_tk::Image> out;
+            if (1 == video.layers.size() &&
+                video.layers.front().image &&
+                !video.layers.front().imageB &&
+                tl::timeline::Transition::None == video.layers.front().transition)
+            {
+                const auto& image = video.layers.front().image;
+                const feather_tk::ImageInfo& info = image->getInfo();
+                if (info.size == p.info.size &&
+                    info.type == p.info.type &&
+                    info.layout.alignment == p.info.layout.alignment &&
+                    info.layout.endian == p.info.layout.endian &&
+                    info.layout.mirror.x == p.info.layout.mirror.x)
+                {
+                    // The only conversion done on the CPU is flipping the
+                    // scanlines, otherwise the frame is rendered.
+                    out = info.layout.mirror.y == p.info.layout.mirror.y ?
+                        image :
+                        flipY(image);
+                }
+            }
+            return out;
+        }
+
+        void ExportJob::_render(int64_t frame, const tl::timeline::VideoData& video)
+        {
+            FEATHER_TK_P();
+            if (!p.render)
+            {
+                _renderInit();
+            }
+            feather_tk::gl::OffscreenBufferBinding binding(p.buffer);
+            p.render->begin(p.info.size);
+            p.render->setOCIOOptions(p.options.ocioOptions);
+            p.render->setLUTOptions(p.options.lutOptions);
+            p.render->drawVideo(
+                { video },
+                { feather_tk::Box2I(0, 0, p.info.size.w, p.info.size.h) },
+                { p.options.imageOptions },
+                { p.options.displayOptions },
+                tl::timeline::CompareOptions(),
+                p.options.colorBuffer);
+            p.render->end();
+
+            glPixelStorei(GL_PACK_ALIGNMENT, p.info.layout.alignment);
+#if defined(FEATHER_TK_API_GL_4_1)
+            glPixelStorei(GL_PACK_SWAP_BYTES, p.info.layout.endian != feather_tk::getEndian());
+
+            // Start an asynchronous read back into the next pixel buffer
+            // object, and finish the read back of the previous frame.
+            const GLuint pbo = p.pbo[p.pboIndex];
+            p.pboIndex = (p.pboIndex + 1) % 2;
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+            glReadPixels(
+                0,
+                0,
+                p.info.size.w,
+                p.info.size.h,
+                p.glFormat,
+                p.glType,
+                NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            p.readbacks.push_back({ frame, pbo });
+            if (p.readbacks.size() > 1)
+            {
+                _readback();
+            }
+#else // FEATHER_TK_API_GL_4_1
+            auto image = feather_tk::Image::create(p.info);
+            glReadPixels(
+                0,
+                0,
+                p.info.size.w,
+                p.info.size.h,
+                p.glFormat,
+                p.glType,
+                image->getData());
+            _write(frame, image);
+#endif // FEATHER_TK_API_GL_4_1
+        }
+
+        void ExportJob::_readback()
+        {
+            FEATHER_TK_P();
+#if defined(FEATHER_TK_API_GL_4_1)
+            if (!p.readbacks.empty())
+            {
+                const auto readback = p.readbacks.front();
+                p.readbacks.pop_front();
+                auto image = feather_tk::Image::create(p.info);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+                if (void* data = glMapBufferRange(
+                    GL_PIXEL_PACK_BUFFER,
+                    0,
+                    image->getByteCount(),
+                    GL_MAP_READ_BIT))
+                {
+                    memcpy(image->getData(), data, image->getByteCount());
+                    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                }
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                _write(readback.frame, image);
+            }
+#endif // FEATHER_TK_API_GL_4_1
+        }
+
+        void ExportJob::_write(int64_t frame, const std::shared_ptr<feather_tk::Image>& image)
+        {
+            FEATHER_TK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.queue.push_back(std::make_pair(frame, image));
+            }
+            p.cv.notify_one();
+        }
+
+        bool isPassThrough(const ExportOptions& options)
+        {
+            return
+                ExportRenderSize::Default == options.settings.renderSize &&
+                !options.ocioOptions.enabled &&
+                !options.lutOptions.enabled &&
+                options.imageOptions == feather_tk::ImageOptions() &&
+                options.displayOptions == tl::timeline::DisplayOptions();
+        }
+
+        std::string getExportFileName(const ExportSettings& settings, int64_t frame)
+        {
+            std::string out;
+            switch (settings.fileType)
+            {
+            case ExportFileType::Image:
+            case ExportFileType::Sequence:
+            {
+                std::stringstream ss;
+                ss << settings.imageBaseName;
+                ss << std::setfill('0') << std::setw(settings.imageZeroPad) << frame;
+                ss << settings.imageExtension;
+                out = ss.str();
+                break;
+            }
+            case ExportFileType::Movie:
+            {
+                std::stringstream ss;
+                ss << settings.movieBaseName << settings.movieExtension;
+                out = ss.str();
+                break;
+            }
+            default: break;
+            }
+            return out;
+        }
+
+        std::future<std::shared_ptr<tl::timeline::Timeline> > openExportTimeline(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const tl::file::Path& path,
+            const tl::file::Path& audioPath,
+            const tl::timeline::Options& options)
+        {
+            std::weak_ptr<feather_tk::Context> contextWeak(context);
+            return std::async(
+                std::launch::async,
+                [contextWeak, path, audioPath, options]
+                {
+                    std::shared_ptr<tl::timeline::Timeline> out;
+                    if (auto context = contextWeak.lock())
+                    {
+                        auto otioTimeline = audioPath.isEmpty() ?
+                            tl::timeline::create(context, path, options) :
+                            tl::timeline::create(context, path, audioPath, options);
+                        out = tl::timeline::Timeline::create(context, otioTimeline, options);
+                    }
+                    if (!out)
+                    {
+                        throw std::runtime_error(
+                            feather_tk::Format("Cannot open: \"{0}\"").arg(path.get()));
+                    }
+                    return out;
+                });
+        }
+    }
+}
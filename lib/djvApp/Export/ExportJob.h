@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvApp/Models/SettingsModel.h>
+
+#include <tlTimeline/DisplayOptions.h>
+#include <tlTimeline/LUTOptions.h>
+#include <tlTimeline/OCIOOptions.h>
+#include <tlTimeline/Timeline.h>
+
+#include <future>
+
+namespace feather_tk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        class FrameCacheModel;
+
+        //! Export options.
+        struct ExportOptions
+        {
+            ExportSettings settings;
+            OTIO_NS::TimeRange range = tl::time::invalidTimeRange;
+            double speed = 0.0;
+            int videoLayer = 0;
+            tl::timeline::OCIOOptions ocioOptions;
+            tl::timeline::LUTOptions lutOptions;
+            feather_tk::ImageOptions imageOptions;
+            tl::timeline::DisplayOptions displayOptions;
+            feather_tk::ImageType colorBuffer = feather_tk::ImageType::RGBA_U8;
+
+            //! Number of video frames to request ahead of the render.
+            size_t prefetch = 16;
+
+            //! Number of threads used to write image sequences. A value of
+            //! zero uses the number of hardware threads.
+            size_t sequenceThreads = 0;
+
+            //! Maximum number of frames waiting to be written. A value of
+            //! zero uses twice the number of writer threads.
+            size_t writeMax = 0;
+
+            bool operator == (const ExportOptions&) const;
+            bool operator != (const ExportOptions&) const;
+        };
+
+        //! Export job.
+        //!
+        //! The export is pipelined so that decoding, rendering, reading
+        //! back, and encoding the frames overlap. Video is requested from
+        //! the timeline ahead of the render, the render is read back
+        //! asynchronously with pixel buffer objects, and the frames are
+        //! encoded on a separate thread. Image sequences are encoded on
+        //! a pool of threads.
+        //!
+        //! When the export does not change the images (see isPassThrough()),
+        //! the decoded images are written directly and the OpenGL resources
+        //! are only created if a frame still needs to be rendered.
+        //!
+        //! If a frame cache is given, frames that are already decoded are
+        //! taken from the cache and the decoded frames are added to it.
+        class ExportJob : public std::enable_shared_from_this<ExportJob>
+        {
+            FEATHER_TK_NON_COPYABLE(ExportJob);
+
+        protected:
+            void _init(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<tl::timeline::Timeline>&,
+                const ExportOptions&,
+                const std::shared_ptr<FrameCacheModel>&);
+
+            ExportJob();
+
+        public:
+            ~ExportJob();
+
+            //! Create a new export job. The OpenGL context must be current.
+            static std::shared_ptr<ExportJob> create(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<tl::timeline::Timeline>&,
+                const ExportOptions&,
+                const std::shared_ptr<FrameCacheModel>& = nullptr);
+
+            //! Get the output path.
+            const tl::file::Path& getPath() const;
+
+            //! Get the time range.
+            const OTIO_NS::TimeRange& getRange() const;
+
+            //! Get the number of frames that have been written.
+            int64_t getFrameCount() const;
+
+            //! Get the total number of frames.
+            int64_t getFrameTotal() const;
+
+            //! Run the export. This should be called regularly from the
+            //! thread where the OpenGL context is current, it returns
+            //! false when the export is finished. An exception is thrown
+            //! if there is an error.
+            bool tick();
+
+            //! Cancel the export.
+            void cancel();
+
+        private:
+            void _renderInit();
+            std::shared_ptr<feather_tk::Image> _getPassThrough(const tl::timeline::VideoData&);
+            void _render(int64_t frame, const tl::timeline::VideoData&);
+            void _readback();
+            void _write(int64_t frame, const std::shared_ptr<feather_tk::Image>&);
+
+            FEATHER_TK_PRIVATE();
+        };
+
+        //! Get whether the export options allow writing the decoded images
+        //! directly, without rendering them.
+        bool isPassThrough(const ExportOptions&);
+
+        //! Get the export output file name.
+        std::string getExportFileName(const ExportSettings&, int64_t frame);
+
+        //! Open a timeline for exporting on a thread. The future throws an
+        //! exception if the timeline cannot be opened.
+        std::future<std::shared_ptr<tl::timeline::Timeline> > openExportTimeline(
+            const std::shared_ptr<feather_tk::Context>&,
+            const tl::file::Path& path,
+            const tl::file::Path& audioPath,
+            const tl::timeline::Options&);
+    }
+}
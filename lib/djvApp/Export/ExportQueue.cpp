@@ -0,0 +1,357 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Export/ExportQueue.h>
+
+#include <tlTimeline/Util.h>
+
+#include <feather-tk/ui/Settings.h>
+#include <feather-tk/core/Context.h>
+
+#include <filesystem>
+#include <future>
+#include <list>
+#include <set>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            //! Get the output of an export without the frame number, so
+            //! that image sequences with the same base name are equal.
+            std::string getOutput(const ExportSettings& settings)
+            {
+                return (std::filesystem::u8path(settings.directory) /
+                    std::filesystem::u8path(getExportFileName(settings, 0))).lexically_normal().u8string();
+            }
+
+            std::string getUniqueBaseName(const std::string& baseName, int number)
+            {
+                std::string out = baseName;
+                std::string separators;
+                while (!out.empty() &&
+                    ('.' == out.back() || '_' == out.back() || '-' == out.back()))
+                {
+                    separators.insert(separators.begin(), out.back());
+                    out.pop_back();
+                }
+                return out + "_" + std::to_string(number) + separators;
+            }
+        }
+
+        FEATHER_TK_ENUM_IMPL(
+            ExportStatus,
+            "Pending",
+            "Running",
+            "Finished",
+            "Canceled",
+            "Error");
+
+        bool ExportQueueItem::operator == (const ExportQueueItem& other) const
+        {
+            return
+                path == other.path &&
+                audioPath == other.audioPath &&
+                options == other.options &&
+                status == other.status &&
+                output == other.output &&
+                frameCount == other.frameCount &&
+                frameTotal == other.frameTotal &&
+                error == other.error;
+        }
+
+        bool ExportQueueItem::operator != (const ExportQueueItem& other) const
+        {
+            return !(*this == other);
+        }
+
+        struct ExportQueue::Private
+        {
+            std::weak_ptr<feather_tk::Context> context;
+            std::shared_ptr<feather_tk::Settings> settings;
+            std::shared_ptr<FrameCacheModel> frameCache;
+
+            struct Job
+            {
+                ExportQueueItem item;
+                tl::timeline::Options timelineOptions;
+                std::future<std::shared_ptr<tl::timeline::Timeline> > timeline;
+                std::shared_ptr<ExportJob> job;
+            };
+            std::vector<std::shared_ptr<Job> > queue;
+            std::list<std::future<std::shared_ptr<tl::timeline::Timeline> > > canceled;
+
+            std::shared_ptr<feather_tk::ObservableList<ExportQueueItem> > items;
+            std::shared_ptr<feather_tk::ObservableValue<int> > jobs;
+        };
+
+        void ExportQueue::_init(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<feather_tk::Settings>& settings,
+            const std::shared_ptr<FrameCacheModel>& frameCache)
+        {
+            FEATHER_TK_P();
+
+            p.context = context;
+            p.settings = settings;
+            p.frameCache = frameCache;
+
+            int jobs = 2;
+            p.settings->get("/ExportQueue/Jobs", jobs);
+            p.items = feather_tk::ObservableList<ExportQueueItem>::create();
+            p.jobs = feather_tk::ObservableValue<int>::create(std::max(1, jobs));
+        }
+
+        ExportQueue::ExportQueue() :
+            _p(new Private)
+        {}
+
+        ExportQueue::~ExportQueue()
+        {
+            FEATHER_TK_P();
+            p.settings->set("/ExportQueue/Jobs", p.jobs->get());
+        }
+
+        std::shared_ptr<ExportQueue> ExportQueue::create(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<feather_tk::Settings>& settings,
+            const std::shared_ptr<FrameCacheModel>& frameCache)
+        {
+            auto out = std::shared_ptr<ExportQueue>(new ExportQueue);
+            out->_init(context, settings, frameCache);
+            return out;
+        }
+
+        const std::vector<ExportQueueItem>& ExportQueue::getItems() const
+        {
+            return _p->items->get();
+        }
+
+        std::shared_ptr<feather_tk::IObservableList<ExportQueueItem> > ExportQueue::observeItems() const
+        {
+            return _p->items;
+        }
+
+        void ExportQueue::add(
+            const ExportQueueItem& item,
+            const tl::timeline::Options& timelineOptions)
+        {
+            FEATHER_TK_P();
+            auto job = std::make_shared<Private::Job>();
+            job->item = item;
+            job->item.status = ExportStatus::Pending;
+
+            // Number the output if it is the same as the output of another
+            // job, so that the jobs do not overwrite each other's files.
+            std::set<std::string> outputs;
+            for (const auto& i : p.queue)
+            {
+                if (ExportStatus::Pending == i->item.status ||
+                    ExportStatus::Running == i->item.status)
+                {
+                    outputs.insert(getOutput(i->item.options.settings));
+                }
+            }
+            auto& settings = job->item.options.settings;
+            const ExportSettings base = settings;
+            for (int i = 2; outputs.find(getOutput(settings)) != outputs.end(); ++i)
+            {
+                settings.imageBaseName = getUniqueBaseName(base.imageBaseName, i);
+                settings.movieBaseName = getUniqueBaseName(base.movieBaseName, i);
+            }
+
+            job->timelineOptions = timelineOptions;
+            p.queue.push_back(job);
+            _itemsUpdate();
+        }
+
+        void ExportQueue::cancel(int index)
+        {
+            FEATHER_TK_P();
+            if (index >= 0 && index < p.queue.size())
+            {
+                const auto& job = p.queue[index];
+                if (ExportStatus::Pending == job->item.status ||
+                    ExportStatus::Running == job->item.status)
+                {
+                    job->item.status = ExportStatus::Canceled;
+                    job->job.reset();
+                    if (job->timeline.valid())
+                    {
+                        // Don't wait for the timeline to finish loading.
+                        p.canceled.push_back(std::move(job->timeline));
+                    }
+                    _itemsUpdate();
+                }
+            }
+        }
+
+        void ExportQueue::cancelAll()
+        {
+            FEATHER_TK_P();
+            for (size_t i = 0; i < p.queue.size(); ++i)
+            {
+                cancel(i);
+            }
+        }
+
+        void ExportQueue::clear()
+        {
+            FEATHER_TK_P();
+            auto i = p.queue.begin();
+            while (i != p.queue.end())
+            {
+                if (ExportStatus::Pending == (*i)->item.status ||
+                    ExportStatus::Running == (*i)->item.status)
+                {
+                    ++i;
+                }
+                else
+                {
+                    i = p.queue.erase(i);
+                }
+            }
+            _itemsUpdate();
+        }
+
+        int ExportQueue::getJobs() const
+        {
+            return _p->jobs->get();
+        }
+
+        std::shared_ptr<feather_tk::IObservableValue<int> > ExportQueue::observeJobs() const
+        {
+            return _p->jobs;
+        }
+
+        void ExportQueue::setJobs(int value)
+        {
+            _p->jobs->setIfChanged(std::max(1, value));
+        }
+
+        void ExportQueue::tick()
+        {
+            FEATHER_TK_P();
+            if (auto context = p.context.lock())
+            {
+                // Release the canceled timelines once they have finished loading.
+                auto i = p.canceled.begin();
+                while (i != p.canceled.end())
+                {
+                    if (i->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        i = p.canceled.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+
+                // Run the active jobs.
+                bool changed = false;
+                int running = 0;
+                for (const auto& job : p.queue)
+                {
+                    if (ExportStatus::Running == job->item.status)
+                    {
+                        try
+                        {
+                            if (job->timeline.valid() &&
+                                job->timeline.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                            {
+                                auto timeline = job->timeline.get();
+                                if (tl::time::compareExact(job->item.options.range, tl::time::invalidTimeRange))
+                                {
+                                    const OTIO_NS::TimeRange& timeRange = timeline->getTimeRange();
+                                    job->item.options.range = ExportFileType::Image == job->item.options.settings.fileType ?
+                                        OTIO_NS::TimeRange(
+                                            timeRange.start_time(),
+                                            OTIO_NS::RationalTime(1.0, timeRange.duration().rate())) :
+                                        timeRange;
+                                }
+                                ExportOptions options = job->item.options;
+                                if (0 == options.sequenceThreads)
+                                {
+                                    // Share the hardware threads between the jobs.
+                                    options.sequenceThreads = std::max(
+                                        std::thread::hardware_concurrency() / static_cast<unsigned int>(std::max(p.jobs->get(), 1)),
+                                        1U);
+                                }
+                                job->job = ExportJob::create(context, timeline, options, p.frameCache);
+                                job->item.output = job->job->getPath().get();
+                                job->item.frameTotal = job->job->getFrameTotal();
+                                changed = true;
+                            }
+                            if (job->job)
+                            {
+                                const bool active = job->job->tick();
+                                const int64_t frameCount = job->job->getFrameCount();
+                                if (frameCount != job->item.frameCount)
+                                {
+                                    job->item.frameCount = frameCount;
+                                    changed = true;
+                                }
+                                if (!active)
+                                {
+                                    job->item.status = ExportStatus::Finished;
+                                    job->job.reset();
+                                    changed = true;
+                                }
+                            }
+                        }
+                        catch (const std::exception& e)
+                        {
+                            job->item.status = ExportStatus::Error;
+                            job->item.error = e.what();
+                            job->job.reset();
+                            changed = true;
+                            context->log("djv::app::ExportQueue", e.what(), feather_tk::LogType::Error);
+                        }
+                        if (ExportStatus::Running == job->item.status)
+                        {
+                            ++running;
+                        }
+                    }
+                }
+
+                // Start the pending jobs.
+                for (const auto& job : p.queue)
+                {
+                    if (ExportStatus::Pending == job->item.status &&
+                        running < p.jobs->get())
+                    {
+                        job->item.status = ExportStatus::Running;
+                        job->timeline = openExportTimeline(
+                            context,
+                            job->item.path,
+                            job->item.audioPath,
+                            job->timelineOptions);
+                        ++running;
+                        changed = true;
+                    }
+                }
+
+                if (changed)
+                {
+                    _itemsUpdate();
+                }
+            }
+        }
+
+        void ExportQueue::_itemsUpdate()
+        {
+            FEATHER_TK_P();
+            std::vector<ExportQueueItem> items;
+            for (const auto& job : p.queue)
+            {
+                items.push_back(job->item);
+            }
+            p.items->setIfChanged(items);
+        }
+    }
+}
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvApp/Export/ExportJob.h>
+
+#include <feather-tk/core/ObservableList.h>
+#include <feather-tk/core/ObservableValue.h>
+
+namespace feather_tk
+{
+    class Settings;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        //! Export queue status.
+        enum class ExportStatus
+        {
+            Pending,
+            Running,
+            Finished,
+            Canceled,
+            Error,
+
+            Count,
+            First = Pending
+        };
+        FEATHER_TK_ENUM(ExportStatus);
+
+        //! Export queue item.
+        struct ExportQueueItem
+        {
+            tl::file::Path path;
+            tl::file::Path audioPath;
+            ExportOptions options;
+
+            ExportStatus status = ExportStatus::Pending;
+            std::string output;
+            int64_t frameCount = 0;
+            int64_t frameTotal = 0;
+            std::string error;
+
+            bool operator == (const ExportQueueItem&) const;
+            bool operator != (const ExportQueueItem&) const;
+        };
+
+        //! Export queue.
+        //!
+        //! The queue runs several exports at the same time. Each export
+        //! has its own decoding and encoding threads, and the renders are
+        //! interleaved on the thread where the OpenGL context is current.
+        class ExportQueue : public std::enable_shared_from_this<ExportQueue>
+        {
+            FEATHER_TK_NON_COPYABLE(ExportQueue);
+
+        protected:
+            void _init(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<feather_tk::Settings>&,
+                const std::shared_ptr<FrameCacheModel>&);
+
+            ExportQueue();
+
+        public:
+            ~ExportQueue();
+
+            //! Create a new queue.
+            static std::shared_ptr<ExportQueue> create(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<feather_tk::Settings>&,
+                const std::shared_ptr<FrameCacheModel>& = nullptr);
+
+            //! Get the items.
+            const std::vector<ExportQueueItem>& getItems() const;
+
+            //! Observe the items.
+            std::shared_ptr<feather_tk::IObservableList<ExportQueueItem> > observeItems() const;
+
+            //! Add an item. The output is numbered if it is the same as
+            //! the output of a pending or running item.
+            void add(const ExportQueueItem&, const tl::timeline::Options&);
+
+            //! Cancel an item.
+            void cancel(int index);
+
+            //! Cancel all of the items.
+            void cancelAll();
+
+            //! Remove the items that are not pending or running.
+            void clear();
+
+            //! \name Jobs
+            //! Set the maximum number of exports that are run at the same
+            //! time.
+            ///@{
+
+            int getJobs() const;
+            std::shared_ptr<feather_tk::IObservableValue<int> > observeJobs() const;
+            void setJobs(int);
+
+            ///@}
+
+            //! Run the queue. This should be called regularly from the
+            //! thread where the OpenGL context is current.
+            void tick();
+
+        private:
+            void _itemsUpdate();
+
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
@@ -132,6 +132,7 @@ namespace djv
             std::shared_ptr<feather_tk::ValueObserver<MouseSettings> > mouseSettingsObserver;
             std::shared_ptr<feather_tk::ValueObserver<TimelineSettings> > timelineSettingsObserver;
             std::shared_ptr<feather_tk::ValueObserver<bool> > timelineFrameViewObserver;
+            std::shared_ptr<feather_tk::ValueObserver<bool> > timelineScrubObserver;
             std::shared_ptr<feather_tk::ValueObserver<WindowSettings> > windowSettingsObserver;
         };
 
@@ -371,6 +372,13 @@ namespace djv
                     }
                 });
 
+            p.timelineScrubObserver = feather_tk::ValueObserver<bool>::create(
+                p.timelineWidget->observeScrub(),
+                [this](bool value)
+                {
+                    _p->viewport->setScrub(value);
+                });
+
             p.windowSettingsObserver = feather_tk::ValueObserver<WindowSettings>::create(
                 p.settingsModel->observeWindow(),
                 [this](const WindowSettings& value)
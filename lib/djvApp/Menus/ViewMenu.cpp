@@ -30,9 +30,18 @@ namespace djv
             addDivider();
             addAction(actions["MirrorHorizontal"]);
             addAction(actions["MirrorVertical"]);
+#if defined(TLRENDER_USD)
+            addDivider();
+            addAction(actions["Proxy"]);
+            addAction(actions["ProxyHalf"]);
+            addAction(actions["ProxyQuarter"]);
+            addAction(actions["ProxyEighth"]);
+#endif // TLRENDER_USD
             addDivider();
             addAction(actions["Grid"]);
             addAction(actions["HUD"]);
+            addAction(actions["FrameGraph"]);
+            addAction(actions["FrameTiming"]);
         }
 
         ViewMenu::~ViewMenu()
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Models/BinaryIO.h>
+
+#include <cstring>
+
+namespace djv
+{
+    namespace app
+    {
+        void BinaryWriter::write(const void* data, size_t size)
+        {
+            const uint8_t* p = static_cast<const uint8_t*>(data);
+            _data.insert(_data.end(), p, p + size);
+        }
+
+        void BinaryWriter::writeU8(uint8_t value)
+        {
+            _data.push_back(value);
+        }
+
+        void BinaryWriter::writeU32(uint32_t value)
+        {
+            for (size_t i = 0; i < 4; ++i)
+            {
+                _data.push_back(static_cast<uint8_t>(value >> (i * 8)));
+            }
+        }
+
+        void BinaryWriter::writeU64(uint64_t value)
+        {
+            for (size_t i = 0; i < 8; ++i)
+            {
+                _data.push_back(static_cast<uint8_t>(value >> (i * 8)));
+            }
+        }
+
+        void BinaryWriter::writeI32(int32_t value)
+        {
+            writeU32(static_cast<uint32_t>(value));
+        }
+
+        void BinaryWriter::writeF32(float value)
+        {
+            uint32_t tmp = 0;
+            memcpy(&tmp, &value, sizeof(uint32_t));
+            writeU32(tmp);
+        }
+
+        void BinaryWriter::writeF64(double value)
+        {
+            uint64_t tmp = 0;
+            memcpy(&tmp, &value, sizeof(uint64_t));
+            writeU64(tmp);
+        }
+
+        const std::vector<uint8_t>& BinaryWriter::getData() const
+        {
+            return _data;
+        }
+
+        BinaryReader::BinaryReader(const uint8_t* data, size_t size) :
+            _data(data),
+            _size(size)
+        {}
+
+        bool BinaryReader::read(void* data, size_t size)
+        {
+            if (_pos + size <= _size)
+            {
+                memcpy(data, _data + _pos, size);
+                _pos += size;
+            }
+            else
+            {
+                memset(data, 0, size);
+                _error = true;
+            }
+            return !_error;
+        }
+
+        uint8_t BinaryReader::readU8()
+        {
+            uint8_t out = 0;
+            read(&out, sizeof(uint8_t));
+            return out;
+        }
+
+        uint32_t BinaryReader::readU32()
+        {
+            uint8_t tmp[4];
+            read(tmp, 4);
+            uint32_t out = 0;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                out |= static_cast<uint32_t>(tmp[i]) << (i * 8);
+            }
+            return out;
+        }
+
+        uint64_t BinaryReader::readU64()
+        {
+            uint8_t tmp[8];
+            read(tmp, 8);
+            uint64_t out = 0;
+            for (size_t i = 0; i < 8; ++i)
+            {
+                out |= static_cast<uint64_t>(tmp[i]) << (i * 8);
+            }
+            return out;
+        }
+
+        int32_t BinaryReader::readI32()
+        {
+            return static_cast<int32_t>(readU32());
+        }
+
+        float BinaryReader::readF32()
+        {
+            const uint32_t tmp = readU32();
+            float out = 0.F;
+            memcpy(&out, &tmp, sizeof(float));
+            return out;
+        }
+
+        double BinaryReader::readF64()
+        {
+            const uint64_t tmp = readU64();
+            double out = 0.0;
+            memcpy(&out, &tmp, sizeof(double));
+            return out;
+        }
+
+        size_t BinaryReader::getPos() const
+        {
+            return _pos;
+        }
+
+        bool BinaryReader::hasError() const
+        {
+            return _error;
+        }
+    }
+}
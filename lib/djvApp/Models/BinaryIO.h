@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace djv
+{
+    namespace app
+    {
+        //! Binary data writer. The values are written in little endian byte
+        //! order, so the files written by the caches do not depend on the
+        //! padding of structures or the byte order of the computer.
+        class BinaryWriter
+        {
+        public:
+            void write(const void*, size_t);
+            void writeU8(uint8_t);
+            void writeU32(uint32_t);
+            void writeU64(uint64_t);
+            void writeI32(int32_t);
+            void writeF32(float);
+            void writeF64(double);
+
+            //! Get the data that has been written.
+            const std::vector<uint8_t>& getData() const;
+
+        private:
+            std::vector<uint8_t> _data;
+        };
+
+        //! Binary data reader. Reading past the end of the data sets the
+        //! error flag and returns zero.
+        class BinaryReader
+        {
+        public:
+            BinaryReader(const uint8_t* data, size_t size);
+
+            bool read(void*, size_t);
+            uint8_t readU8();
+            uint32_t readU32();
+            uint64_t readU64();
+            int32_t readI32();
+            float readF32();
+            double readF64();
+
+            //! Get the current position.
+            size_t getPos() const;
+
+            //! Get whether there was an attempt to read past the end of the
+            //! data.
+            bool hasError() const;
+
+        private:
+            const uint8_t* _data = nullptr;
+            size_t _size = 0;
+            size_t _pos = 0;
+            bool _error = false;
+        };
+    }
+}
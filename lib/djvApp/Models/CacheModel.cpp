@@ -0,0 +1,329 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Models/CacheModel.h>
+
+#include <djvApp/Models/SettingsModel.h>
+
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/Timer.h>
+
+#if defined(_WINDOWS)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#else // _WINDOWS
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#endif // _WINDOWS
+
+#include <algorithm>
+#include <cmath>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            const float gigabyte = 1024.F * 1024.F * 1024.F;
+
+            //! How often the available memory is checked.
+            const std::chrono::milliseconds timeout(2000);
+
+            //! The minimum change in gigabytes before the cache is resized.
+            const float hysteresisGB = .25F;
+
+            //! The minimum change as a fraction of the cache size before
+            //! the cache is resized.
+            const float hysteresisFraction = .1F;
+
+#if !defined(_WINDOWS) && !defined(__APPLE__)
+            bool readValue(const std::string& fileName, uint64_t& value)
+            {
+                bool out = false;
+                std::ifstream file(fileName);
+                std::string s;
+                if (file >> s && s != "max")
+                {
+                    std::stringstream ss(s);
+                    out = static_cast<bool>(ss >> value);
+                }
+                return out;
+            }
+
+            //! Get the cgroup of the process. The cgroup v2 path is in the
+            //! line with a hierarchy ID of zero, the cgroup v1 path is in
+            //! the line with the memory controller.
+            void getCgroup(std::string& v2, std::string& v1)
+            {
+                std::ifstream file("/proc/self/cgroup");
+                std::string line;
+                while (std::getline(file, line))
+                {
+                    const size_t a = line.find(':');
+                    const size_t b = a != std::string::npos ? line.find(':', a + 1) : std::string::npos;
+                    if (b != std::string::npos)
+                    {
+                        const std::string id = line.substr(0, a);
+                        const std::string controllers = line.substr(a + 1, b - a - 1);
+                        const std::string path = line.substr(b + 1);
+                        if ("0" == id && controllers.empty())
+                        {
+                            v2 = path;
+                        }
+                        else
+                        {
+                            std::stringstream ss(controllers);
+                            std::string controller;
+                            while (std::getline(ss, controller, ','))
+                            {
+                                if ("memory" == controller)
+                                {
+                                    v1 = path;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            //! Get the memory available in a cgroup hierarchy. The limit
+            //! may be set on the cgroup or any of its parents, so the
+            //! smallest amount available is used.
+            uint64_t getCgroupAvailable(
+                const std::filesystem::path& root,
+                const std::string& cgroup,
+                const std::string& maxFileName,
+                const std::string& currentFileName)
+            {
+                uint64_t out = std::numeric_limits<uint64_t>::max();
+                std::filesystem::path path = root / std::filesystem::path(cgroup).relative_path();
+                bool done = false;
+                while (!done)
+                {
+                    uint64_t limit = 0;
+                    uint64_t usage = 0;
+                    if (readValue((path / maxFileName).string(), limit) &&
+                        readValue((path / currentFileName).string(), usage))
+                    {
+                        out = std::min(out, limit > usage ? (limit - usage) : 0);
+                    }
+                    if (path == root || !path.has_relative_path() || path.parent_path() == path)
+                    {
+                        done = true;
+                    }
+                    else
+                    {
+                        path = path.parent_path();
+                    }
+                }
+                return out;
+            }
+
+            uint64_t getCgroupAvailable()
+            {
+                uint64_t out = std::numeric_limits<uint64_t>::max();
+                std::string v2;
+                std::string v1;
+                getCgroup(v2, v1);
+                if (!v2.empty())
+                {
+                    out = std::min(out, getCgroupAvailable(
+                        "/sys/fs/cgroup",
+                        v2,
+                        "memory.max",
+                        "memory.current"));
+                }
+                if (!v1.empty())
+                {
+                    out = std::min(out, getCgroupAvailable(
+                        "/sys/fs/cgroup/memory",
+                        v1,
+                        "memory.limit_in_bytes",
+                        "memory.usage_in_bytes"));
+                }
+                return out;
+            }
+#endif // _WINDOWS
+        }
+
+        float getAvailableMemoryGB()
+        {
+            uint64_t out = 0;
+#if defined(_WINDOWS)
+            MEMORYSTATUSEX status;
+            status.dwLength = sizeof(status);
+            if (GlobalMemoryStatusEx(&status))
+            {
+                out = status.ullAvailPhys;
+            }
+#elif defined(__APPLE__)
+            vm_statistics64_data_t stats;
+            mach_msg_type_number_t count = HOST_VM_INFO64_COUNT;
+            vm_size_t pageSize = 0;
+            if (KERN_SUCCESS == host_page_size(mach_host_self(), &pageSize) &&
+                KERN_SUCCESS == host_statistics64(
+                    mach_host_self(),
+                    HOST_VM_INFO64,
+                    reinterpret_cast<host_info64_t>(&stats),
+                    &count))
+            {
+                out = (static_cast<uint64_t>(stats.free_count) +
+                    static_cast<uint64_t>(stats.inactive_count)) *
+                    static_cast<uint64_t>(pageSize);
+            }
+#else // _WINDOWS
+            std::ifstream file("/proc/meminfo");
+            std::string line;
+            while (std::getline(file, line))
+            {
+                std::stringstream ss(line);
+                std::string key;
+                uint64_t value = 0;
+                if (ss >> key >> value && "MemAvailable:" == key)
+                {
+                    out = value * 1024;
+                    break;
+                }
+            }
+            out = std::min(out, getCgroupAvailable());
+#endif // _WINDOWS
+            return out / gigabyte;
+        }
+
+        struct CacheModel::Private
+        {
+            std::weak_ptr<feather_tk::Context> context;
+            std::shared_ptr<SettingsModel> settingsModel;
+            float usage = 0.F;
+
+            std::shared_ptr<feather_tk::ObservableValue<tl::timeline::PlayerCacheOptions> > cacheOptions;
+            std::shared_ptr<feather_tk::ObservableValue<float> > availableGB;
+
+            std::shared_ptr<feather_tk::Timer> timer;
+            std::shared_ptr<feather_tk::ValueObserver<tl::timeline::PlayerCacheOptions> > cacheObserver;
+            std::shared_ptr<feather_tk::ValueObserver<AutoCacheSettings> > autoCacheObserver;
+        };
+
+        void CacheModel::_init(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<SettingsModel>& settingsModel)
+        {
+            FEATHER_TK_P();
+
+            p.context = context;
+            p.settingsModel = settingsModel;
+
+            p.cacheOptions = feather_tk::ObservableValue<tl::timeline::PlayerCacheOptions>::create(
+                settingsModel->getCache());
+            p.availableGB = feather_tk::ObservableValue<float>::create(0.F);
+
+            p.timer = feather_tk::Timer::create(context);
+            p.timer->setRepeating(true);
+            p.timer->start(
+                timeout,
+                [this]
+                {
+                    _update();
+                });
+
+            p.cacheObserver = feather_tk::ValueObserver<tl::timeline::PlayerCacheOptions>::create(
+                settingsModel->observeCache(),
+                [this](const tl::timeline::PlayerCacheOptions&)
+                {
+                    _update();
+                });
+
+            p.autoCacheObserver = feather_tk::ValueObserver<AutoCacheSettings>::create(
+                settingsModel->observeAutoCache(),
+                [this](const AutoCacheSettings&)
+                {
+                    _update();
+                });
+        }
+
+        CacheModel::CacheModel() :
+            _p(new Private)
+        {}
+
+        CacheModel::~CacheModel()
+        {}
+
+        std::shared_ptr<CacheModel> CacheModel::create(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<SettingsModel>& settingsModel)
+        {
+            auto out = std::shared_ptr<CacheModel>(new CacheModel);
+            out->_init(context, settingsModel);
+            return out;
+        }
+
+        const tl::timeline::PlayerCacheOptions& CacheModel::getCacheOptions() const
+        {
+            return _p->cacheOptions->get();
+        }
+
+        std::shared_ptr<feather_tk::IObservableValue<tl::timeline::PlayerCacheOptions> > CacheModel::observeCacheOptions() const
+        {
+            return _p->cacheOptions;
+        }
+
+        std::shared_ptr<feather_tk::IObservableValue<float> > CacheModel::observeAvailableGB() const
+        {
+            return _p->availableGB;
+        }
+
+        void CacheModel::setCacheUsage(float value)
+        {
+            _p->usage = std::max(value, 0.F);
+        }
+
+        void CacheModel::_update()
+        {
+            FEATHER_TK_P();
+            const float availableGB = getAvailableMemoryGB();
+            p.availableGB->setIfChanged(availableGB);
+
+            tl::timeline::PlayerCacheOptions options = p.settingsModel->getCache();
+            const AutoCacheSettings& autoCache = p.settingsModel->getAutoCache();
+            if (autoCache.enabled && availableGB > 0.F)
+            {
+                // The memory used by the cache is counted as available,
+                // otherwise the cache would shrink as it fills.
+                float gb = (availableGB + p.usage) * autoCache.percentage / 100.F;
+                if (autoCache.maxGB > 0.F)
+                {
+                    gb = std::min(gb, autoCache.maxGB);
+                }
+                gb = std::max(gb, autoCache.minGB);
+
+                // Only resize the cache when the change is large enough,
+                // since resizing discards frames.
+                const float prevGB = p.cacheOptions->get().videoGB;
+                const float threshold = std::max(hysteresisGB, prevGB * hysteresisFraction);
+                options.videoGB = std::fabs(gb - prevGB) > threshold ?
+                    std::round(gb * 100.F) / 100.F :
+                    prevGB;
+            }
+            if (p.cacheOptions->setIfChanged(options))
+            {
+                if (auto context = p.context.lock())
+                {
+                    context->log(
+                        "djv::app::CacheModel",
+                        feather_tk::Format("Video cache: {0}GB, available memory: {1}GB").
+                        arg(options.videoGB, 2).
+                        arg(availableGB, 2));
+                }
+            }
+        }
+    }
+}
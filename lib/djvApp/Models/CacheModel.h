@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/Player.h>
+
+#include <feather-tk/core/ObservableValue.h>
+
+namespace feather_tk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        class SettingsModel;
+
+        //! Get the available physical memory in gigabytes. On Linux the
+        //! value is limited by the cgroup memory limit when there is one.
+        float getAvailableMemoryGB();
+
+        //! Cache model.
+        //!
+        //! This model provides the cache options used by the players. When
+        //! the automatic cache is enabled the video cache size is computed
+        //! from the available memory, and updated periodically so that the
+        //! cache shrinks under memory pressure and grows when memory is
+        //! released.
+        class CacheModel : public std::enable_shared_from_this<CacheModel>
+        {
+            FEATHER_TK_NON_COPYABLE(CacheModel);
+
+        protected:
+            void _init(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<SettingsModel>&);
+
+            CacheModel();
+
+        public:
+            ~CacheModel();
+
+            //! Create a new model.
+            static std::shared_ptr<CacheModel> create(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<SettingsModel>&);
+
+            //! Get the effective cache options.
+            const tl::timeline::PlayerCacheOptions& getCacheOptions() const;
+
+            //! Observe the effective cache options.
+            std::shared_ptr<feather_tk::IObservableValue<tl::timeline::PlayerCacheOptions> > observeCacheOptions() const;
+
+            //! Observe the available memory in gigabytes.
+            std::shared_ptr<feather_tk::IObservableValue<float> > observeAvailableGB() const;
+
+            //! Set the amount of memory in gigabytes currently used by the
+            //! video cache. This memory is counted as available when
+            //! computing the automatic cache size.
+            void setCacheUsage(float);
+
+        private:
+            void _update();
+
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,239 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Models/FileWatcherModel.h>
+
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/Timer.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif // __linux__
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <set>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            const std::chrono::milliseconds timeout(1000);
+
+            int64_t getModifiedTime(const std::string& directory)
+            {
+                std::error_code ec;
+                const auto time = std::filesystem::last_write_time(
+                    std::filesystem::u8path(directory),
+                    ec);
+                return !ec ? time.time_since_epoch().count() : 0;
+            }
+        }
+
+        struct FileWatcherModel::Private
+        {
+            std::weak_ptr<feather_tk::Context> context;
+            std::vector<std::string> directories;
+#if defined(__linux__)
+            int fd = -1;
+            std::map<int, std::string> watches;
+#endif // __linux__
+            std::map<std::string, int64_t> modified;
+            std::set<std::string> changedDirectories;
+            std::shared_ptr<feather_tk::ObservableList<std::string> > changed;
+            std::shared_ptr<feather_tk::Timer> timer;
+
+            void log(const std::string& value)
+            {
+                if (auto context = this->context.lock())
+                {
+                    context->log("djv::app::FileWatcherModel", value, feather_tk::LogType::Error);
+                }
+            }
+        };
+
+        void FileWatcherModel::_init(const std::shared_ptr<feather_tk::Context>& context)
+        {
+            FEATHER_TK_P();
+
+            p.context = context;
+#if defined(__linux__)
+            p.fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (-1 == p.fd)
+            {
+                p.log(feather_tk::Format("Cannot initialize inotify, polling instead: {0}").
+                    arg(strerror(errno)));
+            }
+#endif // __linux__
+
+            p.changed = feather_tk::ObservableList<std::string>::create();
+
+            p.timer = feather_tk::Timer::create(context);
+            p.timer->setRepeating(true);
+            p.timer->start(
+                timeout,
+                [this]
+                {
+                    _tick();
+                });
+        }
+
+        FileWatcherModel::FileWatcherModel() :
+            _p(new Private)
+        {}
+
+        FileWatcherModel::~FileWatcherModel()
+        {
+#if defined(__linux__)
+            FEATHER_TK_P();
+            if (p.fd != -1)
+            {
+                close(p.fd);
+            }
+#endif // __linux__
+        }
+
+        std::shared_ptr<FileWatcherModel> FileWatcherModel::create(
+            const std::shared_ptr<feather_tk::Context>& context)
+        {
+            auto out = std::shared_ptr<FileWatcherModel>(new FileWatcherModel);
+            out->_init(context);
+            return out;
+        }
+
+        void FileWatcherModel::setDirectories(const std::vector<std::string>& value)
+        {
+            FEATHER_TK_P();
+            if (value != p.directories)
+            {
+                p.directories = value;
+                std::vector<std::string> polled;
+#if defined(__linux__)
+                if (p.fd != -1)
+                {
+                    // Remove the watches that are no longer needed.
+                    auto i = p.watches.begin();
+                    while (i != p.watches.end())
+                    {
+                        if (std::find(value.begin(), value.end(), i->second) == value.end())
+                        {
+                            inotify_rm_watch(p.fd, i->first);
+                            i = p.watches.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+
+                    // Add the new watches. Files are reported when they are
+                    // closed after writing, so that partially written files
+                    // are not read.
+                    for (const auto& directory : value)
+                    {
+                        const auto j = std::find_if(
+                            p.watches.begin(),
+                            p.watches.end(),
+                            [directory](const std::pair<int, std::string>& watch)
+                            {
+                                return directory == watch.second;
+                            });
+                        if (j == p.watches.end())
+                        {
+                            const int wd = inotify_add_watch(
+                                p.fd,
+                                directory.c_str(),
+                                IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE);
+                            if (wd != -1)
+                            {
+                                p.watches[wd] = directory;
+                            }
+                            else
+                            {
+                                p.log(feather_tk::Format("Cannot watch \"{0}\", polling instead: {1}").
+                                    arg(directory).
+                                    arg(strerror(errno)));
+                                polled.push_back(directory);
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    polled = value;
+                }
+#else // __linux__
+                polled = value;
+#endif // __linux__
+
+                // Poll the modification times of the directories that are
+                // not watched.
+                std::map<std::string, int64_t> modified;
+                for (const auto& directory : polled)
+                {
+                    const auto i = p.modified.find(directory);
+                    modified[directory] = i != p.modified.end() ?
+                        i->second :
+                        getModifiedTime(directory);
+                }
+                p.modified = modified;
+            }
+        }
+
+        std::shared_ptr<feather_tk::IObservableList<std::string> > FileWatcherModel::observeChanged() const
+        {
+            return _p->changed;
+        }
+
+        void FileWatcherModel::_tick()
+        {
+            FEATHER_TK_P();
+#if defined(__linux__)
+            if (p.fd != -1)
+            {
+                alignas(struct inotify_event) char buf[4096];
+                ssize_t size = 0;
+                while ((size = read(p.fd, buf, sizeof(buf))) > 0)
+                {
+                    const char* ptr = buf;
+                    while (ptr < buf + size)
+                    {
+                        const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(ptr);
+                        const auto i = p.watches.find(event->wd);
+                        if (i != p.watches.end())
+                        {
+                            p.changedDirectories.insert(i->second);
+                        }
+                        ptr += sizeof(struct inotify_event) + event->len;
+                    }
+                }
+            }
+#endif // __linux__
+            for (auto& i : p.modified)
+            {
+                const int64_t modified = getModifiedTime(i.first);
+                if (modified != i.second)
+                {
+                    i.second = modified;
+                    p.changedDirectories.insert(i.first);
+                }
+            }
+            if (!p.changedDirectories.empty())
+            {
+                p.changed->setAlways(std::vector<std::string>(
+                    p.changedDirectories.begin(),
+                    p.changedDirectories.end()));
+                p.changedDirectories.clear();
+            }
+        }
+    }
+}
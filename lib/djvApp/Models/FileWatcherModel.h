@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/core/ObservableList.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace feather_tk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        //! File watcher model.
+        //!
+        //! This watches directories for files that are written, moved, or
+        //! removed. The changed directories are reported at most once per
+        //! second, so that a render writing many frames does not cause a
+        //! refresh for every frame.
+        //!
+        //! On Linux the directories are watched with inotify. On the other
+        //! platforms, and on Linux when a directory cannot be watched, the
+        //! directory modification times are polled instead. A directory's
+        //! modification time only changes when files are added, removed,
+        //! or renamed, so polling does not find files that are overwritten
+        //! in place.
+        class FileWatcherModel : public std::enable_shared_from_this<FileWatcherModel>
+        {
+            FEATHER_TK_NON_COPYABLE(FileWatcherModel);
+
+        protected:
+            void _init(const std::shared_ptr<feather_tk::Context>&);
+
+            FileWatcherModel();
+
+        public:
+            ~FileWatcherModel();
+
+            //! Create a new model.
+            static std::shared_ptr<FileWatcherModel> create(
+                const std::shared_ptr<feather_tk::Context>&);
+
+            //! Set the directories to watch.
+            void setDirectories(const std::vector<std::string>&);
+
+            //! Observe the directories that have changed.
+            std::shared_ptr<feather_tk::IObservableList<std::string> > observeChanged() const;
+
+        private:
+            void _tick();
+
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
@@ -22,6 +22,7 @@ namespace djv
             std::shared_ptr<feather_tk::ObservableList<int> > bIndexes;
             std::shared_ptr<feather_tk::ObservableList<std::shared_ptr<FilesModelItem> > > active;
             std::shared_ptr<feather_tk::ObservableList<int> > layers;
+            std::shared_ptr<feather_tk::ObservableList<bool> > loading;
             std::shared_ptr<feather_tk::ObservableValue<tl::timeline::CompareOptions> > compareOptions;
             std::shared_ptr<feather_tk::ObservableValue<tl::timeline::CompareTime> > compareTime;
         };
@@ -39,6 +40,7 @@ namespace djv
             p.bIndexes = feather_tk::ObservableList<int>::create();
             p.active = feather_tk::ObservableList<std::shared_ptr<FilesModelItem> >::create();
             p.layers = feather_tk::ObservableList<int>::create();
+            p.loading = feather_tk::ObservableList<bool>::create();
             tl::timeline::CompareOptions compareOptions;
             p.settings->getT("/Files/CompareOptions", compareOptions);
             p.compareOptions = feather_tk::ObservableValue<tl::timeline::CompareOptions>::create(compareOptions);
@@ -138,6 +140,7 @@ namespace djv
 
             p.active->setIfChanged(_getActive());
             p.layers->setIfChanged(_getLayers());
+            p.loading->setIfChanged(_getLoading());
         }
 
         void FilesModel::close()
@@ -186,6 +189,7 @@ namespace djv
 
                 p.active->setIfChanged(_getActive());
                 p.layers->setIfChanged(_getLayers());
+                p.loading->setIfChanged(_getLoading());
             }
         }
 
@@ -203,6 +207,7 @@ namespace djv
 
             p.active->setIfChanged(_getActive());
             p.layers->setIfChanged(_getLayers());
+            p.loading->setIfChanged(_getLoading());
         }
 
         void FilesModel::setA(int index)
@@ -485,6 +490,23 @@ namespace djv
             }
         }
 
+        std::shared_ptr<feather_tk::IObservableList<bool> > FilesModel::observeLoading() const
+        {
+            return _p->loading;
+        }
+
+        void FilesModel::setLoading(const std::shared_ptr<FilesModelItem>& item, bool value)
+        {
+            FEATHER_TK_P();
+            const int index = _getIndex(item);
+            if (index != -1 && value != item->loading)
+            {
+                item->loading = value;
+                p.loading->setIfChanged(_getLoading());
+                p.layers->setIfChanged(_getLayers());
+            }
+        }
+
         const tl::timeline::CompareOptions& FilesModel::getCompareOptions() const
         {
             return _p->compareOptions->get();
@@ -633,5 +655,16 @@ namespace djv
             }
             return out;
         }
+
+        std::vector<bool> FilesModel::_getLoading() const
+        {
+            FEATHER_TK_P();
+            std::vector<bool> out;
+            for (const auto& f : p.files->get())
+            {
+                out.push_back(f->loading);
+            }
+            return out;
+        }
     }
 }
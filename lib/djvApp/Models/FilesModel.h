@@ -29,6 +29,8 @@ namespace djv
             std::vector<std::string> videoLayers;
             size_t videoLayer = 0;
 
+            bool loading = false;
+
             double speed = -1.0;
             OTIO_NS::RationalTime currentTime = tl::time::invalidTime;
             OTIO_NS::TimeRange inOutRange = tl::time::invalidTimeRange;
@@ -149,6 +151,12 @@ namespace djv
             //! Set the "A" file to the previous layer.
             void prevLayer();
 
+            //! Observe whether the files are loading.
+            std::shared_ptr<feather_tk::IObservableList<bool> > observeLoading() const;
+
+            //! Set whether a file is loading.
+            void setLoading(const std::shared_ptr<FilesModelItem>&, bool);
+
             //! Get the compare options.
             const tl::timeline::CompareOptions& getCompareOptions() const;
 
@@ -172,6 +180,7 @@ namespace djv
             std::vector<int> _getBIndexes() const;
             std::vector<std::shared_ptr<FilesModelItem> > _getActive() const;
             std::vector<int> _getLayers() const;
+            std::vector<bool> _getLoading() const;
 
             FEATHER_TK_PRIVATE();
         };
@@ -0,0 +1,368 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Models/FrameCacheModel.h>
+
+#include <djvApp/Models/SharedCacheModel.h>
+
+#include <chrono>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            //! How long the file stamps are remembered.
+            const std::chrono::seconds stampTimeout(2);
+
+            struct StampItem
+            {
+                FileStamp stamp;
+                std::chrono::steady_clock::time_point checked;
+            };
+
+            struct StampCache
+            {
+                std::map<std::string, StampItem> items;
+                std::mutex mutex;
+            };
+
+            StampCache& getStampCache()
+            {
+                static StampCache out;
+                return out;
+            }
+
+            FileStamp getCachedFileStamp(const std::string& fileName)
+            {
+                // Remember the file stamps so that the file system is not
+                // queried for every frame.
+                StampCache& cache = getStampCache();
+                const auto now = std::chrono::steady_clock::now();
+                std::unique_lock<std::mutex> lock(cache.mutex);
+                auto i = cache.items.find(fileName);
+                if (i == cache.items.end() || now - i->second.checked > stampTimeout)
+                {
+                    StampItem item;
+                    item.stamp = getFileStamp(fileName);
+                    item.checked = now;
+                    i = cache.items.insert_or_assign(fileName, item).first;
+                }
+                return i->second.stamp;
+            }
+
+            //! Weak references to the images of a frame.
+            struct WeakImages
+            {
+                std::weak_ptr<feather_tk::Image> image;
+                std::weak_ptr<feather_tk::Image> imageB;
+                bool hasImage = false;
+                bool hasImageB = false;
+            };
+
+            std::vector<WeakImages> getWeakImages(const tl::timeline::VideoData& value)
+            {
+                std::vector<WeakImages> out;
+                for (const auto& layer : value.layers)
+                {
+                    WeakImages images;
+                    images.image = layer.image;
+                    images.imageB = layer.imageB;
+                    images.hasImage = static_cast<bool>(layer.image);
+                    images.hasImageB = static_cast<bool>(layer.imageB);
+                    out.push_back(images);
+                }
+                return out;
+            }
+
+            bool isExpired(const std::vector<WeakImages>& value)
+            {
+                bool out = false;
+                for (const auto& images : value)
+                {
+                    out |=
+                        (images.hasImage && images.image.expired()) ||
+                        (images.hasImageB && images.imageB.expired());
+                }
+                return out;
+            }
+        }
+
+        bool FileStamp::operator == (const FileStamp& other) const
+        {
+            return modified == other.modified && size == other.size;
+        }
+
+        bool FileStamp::operator != (const FileStamp& other) const
+        {
+            return !(*this == other);
+        }
+
+        FileStamp getFileStamp(const std::string& fileName)
+        {
+            FileStamp out;
+            const std::filesystem::path path = std::filesystem::u8path(fileName);
+            std::error_code ec;
+            const auto time = std::filesystem::last_write_time(path, ec);
+            if (!ec)
+            {
+                out.modified = time.time_since_epoch().count();
+            }
+            const auto size = std::filesystem::file_size(path, ec);
+            if (!ec)
+            {
+                out.size = size;
+            }
+            return out;
+        }
+
+        std::map<std::string, FileStamp> getFileStamps(const tl::file::Path& path)
+        {
+            std::map<std::string, FileStamp> out;
+            if (path.isSequence())
+            {
+                const feather_tk::RangeI& sequence = path.getSequence();
+                for (int i = sequence.min(); i <= sequence.max(); ++i)
+                {
+                    const std::string fileName = path.get(i);
+                    out[fileName] = getFileStamp(fileName);
+                }
+            }
+            else
+            {
+                const std::string fileName = path.get();
+                out[fileName] = getFileStamp(fileName);
+            }
+            return out;
+        }
+
+        void resetFrameCacheStamps()
+        {
+            StampCache& cache = getStampCache();
+            std::unique_lock<std::mutex> lock(cache.mutex);
+            cache.items.clear();
+        }
+
+        std::string getFrameCacheKey(
+            const tl::file::Path& path,
+            int layer,
+            const OTIO_NS::RationalTime& time,
+            const tl::io::Options& options)
+        {
+            // The options are hashed with FNV-1a, so the keys are the same
+            // between sessions.
+            uint64_t hash = 14695981039346656037ULL;
+            for (const auto& i : options)
+            {
+                for (const char c : i.first + "=" + i.second + ";")
+                {
+                    hash ^= static_cast<uint8_t>(c);
+                    hash *= 1099511628211ULL;
+                }
+            }
+            // Image sequence frames are numbered by the time.
+            const std::string fileName = path.isSequence() ?
+                path.get(static_cast<int>(time.value())) :
+                path.get();
+            const FileStamp stamp = getCachedFileStamp(fileName);
+            std::stringstream ss;
+            ss << fileName << ";" << stamp.modified << ";" << stamp.size << ";" << layer << ";" <<
+                time.value() << "/" << time.rate() << ";" << hash;
+            return ss.str();
+        }
+
+        struct FrameCacheModel::Private
+        {
+            struct Item
+            {
+                std::string key;
+                tl::timeline::VideoData video;
+                std::vector<WeakImages> images;
+            };
+
+            std::shared_ptr<SharedCacheModel> sharedCache;
+            std::list<Item> items;
+            std::unordered_map<std::string, std::list<Item>::iterator> index;
+            mutable std::mutex mutex;
+
+            void evict()
+            {
+                // Remove the frames that are no longer used before the
+                // least recently used frames.
+                if (items.size() > frameCacheMax)
+                {
+                    auto i = items.begin();
+                    while (i != items.end())
+                    {
+                        if (isExpired(i->images))
+                        {
+                            index.erase(i->key);
+                            i = items.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                }
+                while (items.size() > frameCacheMax)
+                {
+                    index.erase(items.back().key);
+                    items.pop_back();
+                }
+            }
+        };
+
+        void FrameCacheModel::_init()
+        {}
+
+        FrameCacheModel::FrameCacheModel() :
+            _p(new Private)
+        {}
+
+        FrameCacheModel::~FrameCacheModel()
+        {}
+
+        std::shared_ptr<FrameCacheModel> FrameCacheModel::create()
+        {
+            auto out = std::shared_ptr<FrameCacheModel>(new FrameCacheModel);
+            out->_init();
+            return out;
+        }
+
+        void FrameCacheModel::setSharedCache(const std::shared_ptr<SharedCacheModel>& value)
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            _p->sharedCache = value;
+        }
+
+        bool FrameCacheModel::contains(const std::string& key) const
+        {
+            FEATHER_TK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const auto i = p.index.find(key);
+            return i != p.index.end() && !isExpired(i->second->images);
+        }
+
+        bool FrameCacheModel::get(const std::string& key, tl::timeline::VideoData& value)
+        {
+            FEATHER_TK_P();
+            bool out = false;
+            std::shared_ptr<SharedCacheModel> sharedCache;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                const auto i = p.index.find(key);
+                if (i != p.index.end())
+                {
+                    // The frame is only returned if all of the images are
+                    // still available.
+                    tl::timeline::VideoData video = i->second->video;
+                    const std::vector<WeakImages>& images = i->second->images;
+                    bool valid = video.layers.size() == images.size();
+                    for (size_t j = 0; j < video.layers.size() && valid; ++j)
+                    {
+                        video.layers[j].image = images[j].image.lock();
+                        video.layers[j].imageB = images[j].imageB.lock();
+                        valid =
+                            (!images[j].hasImage || video.layers[j].image) &&
+                            (!images[j].hasImageB || video.layers[j].imageB);
+                    }
+                    if (valid)
+                    {
+                        p.items.splice(p.items.begin(), p.items, i->second);
+                        value = video;
+                        out = true;
+                    }
+                    else
+                    {
+                        p.items.erase(i->second);
+                        p.index.erase(i);
+                    }
+                }
+                sharedCache = p.sharedCache;
+            }
+            if (!out && sharedCache && sharedCache->get(key, value))
+            {
+                _add(key, value);
+                out = true;
+            }
+            return out;
+        }
+
+        void FrameCacheModel::add(const std::string& key, const tl::timeline::VideoData& value)
+        {
+            FEATHER_TK_P();
+            std::shared_ptr<SharedCacheModel> sharedCache;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                sharedCache = p.sharedCache;
+            }
+            _add(key, value);
+            if (sharedCache)
+            {
+                sharedCache->add(key, value);
+            }
+        }
+
+        void FrameCacheModel::remove(const std::string& fileName)
+        {
+            FEATHER_TK_P();
+            const std::string prefix = fileName + ";";
+            std::unique_lock<std::mutex> lock(p.mutex);
+            auto i = p.items.begin();
+            while (i != p.items.end())
+            {
+                if (0 == i->key.compare(0, prefix.size(), prefix))
+                {
+                    p.index.erase(i->key);
+                    i = p.items.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+        void FrameCacheModel::clear()
+        {
+            FEATHER_TK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.items.clear();
+            p.index.clear();
+        }
+
+        void FrameCacheModel::_add(const std::string& key, const tl::timeline::VideoData& value)
+        {
+            FEATHER_TK_P();
+            Private::Item item;
+            item.key = key;
+            item.video = value;
+            item.images = getWeakImages(value);
+            for (auto& layer : item.video.layers)
+            {
+                layer.image.reset();
+                layer.imageB.reset();
+            }
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const auto i = p.index.find(key);
+            if (i != p.index.end())
+            {
+                p.items.erase(i->second);
+                p.index.erase(i);
+            }
+            p.items.push_front(item);
+            p.index[key] = p.items.begin();
+            p.evict();
+        }
+    }
+}
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/Video.h>
+
+#include <tlIO/IO.h>
+
+#include <feather-tk/core/Util.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace djv
+{
+    namespace app
+    {
+        class SharedCacheModel;
+
+        //! File stamp. The modification time and size of a file, used to
+        //! find the files that have changed.
+        struct FileStamp
+        {
+            int64_t modified = 0;
+            uint64_t size = 0;
+
+            bool operator == (const FileStamp&) const;
+            bool operator != (const FileStamp&) const;
+        };
+
+        //! Get the stamp of a file.
+        FileStamp getFileStamp(const std::string& fileName);
+
+        //! Get the stamps of the files for a path. Image sequences have a
+        //! stamp for each frame.
+        std::map<std::string, FileStamp> getFileStamps(const tl::file::Path&);
+
+        //! Forget the file stamps remembered for the frame cache keys, so
+        //! that the next keys use the current stamps.
+        void resetFrameCacheStamps();
+
+        //! Get a frame cache key. The key starts with the name of the
+        //! media file, or the frame file for image sequences, and includes
+        //! the file stamp so that it changes when the file is replaced.
+        std::string getFrameCacheKey(
+            const tl::file::Path&,
+            int layer,
+            const OTIO_NS::RationalTime&,
+            const tl::io::Options&);
+
+        //! The maximum number of frames in the memory cache.
+        const size_t frameCacheMax = 10000;
+
+        //! Frame cache model.
+        //!
+        //! This is an application wide cache of decoded video frames, so
+        //! that frames decoded for one consumer can be reused by the
+        //! others. The frames are keyed by the media path, layer, time,
+        //! and I/O options (see getFrameCacheKey()).
+        //!
+        //! The memory cache only keeps weak references to the images, so
+        //! it does not use any memory of its own. Frames can be found for
+        //! as long as another consumer, like a running export, keeps the
+        //! images. The least recently used frames are removed when the
+        //! number of frames is larger than the maximum.
+        //!
+        //! If there is a shared cache, frames added to the cache are also
+        //! written to it, and frames that are not in memory are read from
+        //! it.
+        //!
+        //! The frames are added and read by exports. Playback decodes the
+        //! frames inside the players, so it does not use the cache.
+        //!
+        //! The cache is thread safe.
+        class FrameCacheModel : public std::enable_shared_from_this<FrameCacheModel>
+        {
+            FEATHER_TK_NON_COPYABLE(FrameCacheModel);
+
+        protected:
+            void _init();
+
+            FrameCacheModel();
+
+        public:
+            ~FrameCacheModel();
+
+            //! Create a new model.
+            static std::shared_ptr<FrameCacheModel> create();
+
+            //! Set the shared cache.
+            void setSharedCache(const std::shared_ptr<SharedCacheModel>&);
+
+            //! Get whether the cache contains a frame.
+            bool contains(const std::string& key) const;
+
+            //! Get a frame from the cache.
+            bool get(const std::string& key, tl::timeline::VideoData&);
+
+            //! Add a frame to the cache.
+            void add(const std::string& key, const tl::timeline::VideoData&);
+
+            //! Remove the frames for a file from the memory cache. Frames
+            //! in the shared cache are not removed, they can no longer be
+            //! found once the file stamp has changed.
+            void remove(const std::string& fileName);
+
+            //! Clear the cache.
+            void clear();
+
+        private:
+            void _add(const std::string& key, const tl::timeline::VideoData&);
+
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
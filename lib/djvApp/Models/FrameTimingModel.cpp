@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Models/FrameTimingModel.h>
+
+#include <feather-tk/core/Error.h>
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/String.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+
+namespace djv
+{
+    namespace app
+    {
+        FEATHER_TK_ENUM_IMPL(
+            FrameTimingStage,
+            "Request",
+            "Video",
+            "DrawBegin",
+            "DrawEnd",
+            "Present");
+
+        int64_t FrameTiming::get(FrameTimingStage stage) const
+        {
+            return stages[static_cast<size_t>(stage)];
+        }
+
+        void FrameTiming::set(FrameTimingStage stage)
+        {
+            stages[static_cast<size_t>(stage)] = std::max<int64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count(),
+                1);
+        }
+
+        bool FrameTiming::has(FrameTimingStage stage) const
+        {
+            return stages[static_cast<size_t>(stage)] != 0;
+        }
+
+        double FrameTiming::getElapsed(FrameTimingStage a, FrameTimingStage b) const
+        {
+            return has(a) && has(b) ? ((get(b) - get(a)) / 1000.0) : 0.0;
+        }
+
+        namespace
+        {
+            const size_t capacity = 1024;
+
+            // Each slot has a sequence number that is odd while the slot
+            // is being written, readers copy the slot and discard it if
+            // the sequence number changed.
+            struct Slot
+            {
+                std::atomic<uint64_t> sequence = 0;
+                FrameTiming timing;
+            };
+        }
+
+        struct FrameTimingModel::Private
+        {
+            std::array<Slot, capacity> slots;
+            std::atomic<uint64_t> count = 0;
+        };
+
+        void FrameTimingModel::_init()
+        {}
+
+        FrameTimingModel::FrameTimingModel() :
+            _p(new Private)
+        {}
+
+        FrameTimingModel::~FrameTimingModel()
+        {}
+
+        std::shared_ptr<FrameTimingModel> FrameTimingModel::create()
+        {
+            auto out = std::shared_ptr<FrameTimingModel>(new FrameTimingModel);
+            out->_init();
+            return out;
+        }
+
+        size_t FrameTimingModel::getCapacity() const
+        {
+            return capacity;
+        }
+
+        uint64_t FrameTimingModel::getCount() const
+        {
+            return _p->count.load(std::memory_order_acquire);
+        }
+
+        void FrameTimingModel::add(const FrameTiming& value)
+        {
+            FEATHER_TK_P();
+            const uint64_t count = p.count.load(std::memory_order_relaxed);
+            Slot& slot = p.slots[count % capacity];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+            slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.timing = value;
+            slot.sequence.store(sequence + 2, std::memory_order_release);
+            p.count.store(count + 1, std::memory_order_release);
+        }
+
+        std::vector<FrameTiming> FrameTimingModel::get(size_t max) const
+        {
+            FEATHER_TK_P();
+            std::vector<FrameTiming> out;
+            const uint64_t count = p.count.load(std::memory_order_acquire);
+            const uint64_t size = std::min(
+                static_cast<uint64_t>(std::min(max, capacity)),
+                count);
+            out.reserve(size);
+            for (uint64_t i = count - size; i < count; ++i)
+            {
+                const Slot& slot = p.slots[i % capacity];
+                const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+                if (0 == sequence % 2)
+                {
+                    const FrameTiming timing = slot.timing;
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+                    {
+                        out.push_back(timing);
+                    }
+                }
+            }
+            return out;
+        }
+
+        void FrameTimingModel::writeTrace(const std::filesystem::path& path) const
+        {
+            const std::vector<FrameTiming> timings = get(capacity);
+            int64_t start = 0;
+            for (const auto& timing : timings)
+            {
+                for (const auto stage : timing.stages)
+                {
+                    if (stage != 0 && (0 == start || stage < start))
+                    {
+                        start = stage;
+                    }
+                }
+            }
+
+            // Each span is shown on a separate track.
+            struct Span
+            {
+                std::string name;
+                FrameTimingStage begin;
+                FrameTimingStage end;
+            };
+            const std::vector<Span> spans =
+            {
+                { "Frame", FrameTimingStage::Request, FrameTimingStage::Present },
+                { "Decode", FrameTimingStage::Request, FrameTimingStage::Video },
+                { "Wait", FrameTimingStage::Video, FrameTimingStage::DrawBegin },
+                { "Render", FrameTimingStage::DrawBegin, FrameTimingStage::DrawEnd },
+                { "Present", FrameTimingStage::DrawEnd, FrameTimingStage::Present }
+            };
+            nlohmann::json events = nlohmann::json::array();
+            for (size_t i = 0; i < spans.size(); ++i)
+            {
+                nlohmann::json event;
+                event["name"] = "thread_name";
+                event["ph"] = "M";
+                event["pid"] = 0;
+                event["tid"] = i;
+                event["args"]["name"] = spans[i].name;
+                events.push_back(event);
+            }
+            for (const auto& timing : timings)
+            {
+                for (size_t i = 0; i < spans.size(); ++i)
+                {
+                    if (timing.has(spans[i].begin) && timing.has(spans[i].end))
+                    {
+                        nlohmann::json event;
+                        event["name"] = spans[i].name;
+                        event["cat"] = "djv";
+                        event["ph"] = "X";
+                        event["ts"] = timing.get(spans[i].begin) - start;
+                        event["dur"] = timing.get(spans[i].end) - timing.get(spans[i].begin);
+                        event["pid"] = 0;
+                        event["tid"] = i;
+                        event["args"]["frame"] = timing.frame;
+                        events.push_back(event);
+                    }
+                }
+            }
+            nlohmann::json json;
+            json["traceEvents"] = events;
+            json["displayTimeUnit"] = "ms";
+
+            std::ofstream file(path);
+            if (!file.is_open())
+            {
+                throw std::runtime_error(
+                    feather_tk::Format("Cannot open: \"{0}\"").arg(path.u8string()));
+            }
+            file << json.dump();
+        }
+    }
+}
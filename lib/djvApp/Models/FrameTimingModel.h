@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/core/Util.h>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace app
+    {
+        //! Frame timing stages.
+        enum class FrameTimingStage
+        {
+            Request,
+            Video,
+            DrawBegin,
+            DrawEnd,
+            Present,
+
+            Count,
+            First = Request
+        };
+        FEATHER_TK_ENUM(FrameTimingStage);
+
+        //! Frame timing.
+        //!
+        //! The stages are recorded in microseconds from an arbitrary start
+        //! time, a value of zero means that the stage was not recorded.
+        struct FrameTiming
+        {
+            double frame = 0.0;
+            std::array<int64_t, static_cast<size_t>(FrameTimingStage::Count)> stages = {};
+
+            //! Get the time of a stage.
+            int64_t get(FrameTimingStage) const;
+
+            //! Set the time of a stage to the current time.
+            void set(FrameTimingStage);
+
+            //! Get whether a stage has been recorded.
+            bool has(FrameTimingStage) const;
+
+            //! Get the elapsed time between two stages in milliseconds, or
+            //! zero if either stage has not been recorded.
+            double getElapsed(FrameTimingStage, FrameTimingStage) const;
+        };
+
+        //! Frame timing model.
+        //!
+        //! The frame timings are stored in a fixed size ring buffer that
+        //! can be written and read from different threads without locking.
+        class FrameTimingModel : public std::enable_shared_from_this<FrameTimingModel>
+        {
+            FEATHER_TK_NON_COPYABLE(FrameTimingModel);
+
+        protected:
+            void _init();
+
+            FrameTimingModel();
+
+        public:
+            ~FrameTimingModel();
+
+            //! Create a new model.
+            static std::shared_ptr<FrameTimingModel> create();
+
+            //! Get the maximum number of frame timings.
+            size_t getCapacity() const;
+
+            //! Get the total number of frame timings that have been added.
+            uint64_t getCount() const;
+
+            //! Add a frame timing. This should only be called from one
+            //! thread.
+            void add(const FrameTiming&);
+
+            //! Get the most recent frame timings, from oldest to newest.
+            std::vector<FrameTiming> get(size_t max) const;
+
+            //! Write the frame timings as a Chrome trace JSON file (see
+            //! chrome://tracing or https://ui.perfetto.dev).
+            void writeTrace(const std::filesystem::path&) const;
+
+        private:
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Models/ReadAheadModel.h>
+
+#include <djvApp/Models/CacheModel.h>
+#include <djvApp/Models/SettingsModel.h>
+
+#include <feather-tk/core/ObservableList.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            //! The read behind is rounded so that small changes do not
+            //! update the cache.
+            const double readBehindRound = 10.0;
+        }
+
+        double getReadBehind(
+            double readBehind,
+            double speed,
+            double defaultSpeed,
+            tl::timeline::Loop loop,
+            double rangeSeconds,
+            double cacheSeconds)
+        {
+            double out = readBehind;
+
+            // Scale the read behind by the speed multiplier.
+            if (defaultSpeed > 0.0)
+            {
+                out *= std::max(std::fabs(speed / defaultSpeed), 1.0);
+            }
+
+            if (cacheSeconds > 0.0 && rangeSeconds > 0.0)
+            {
+                switch (loop)
+                {
+                case tl::timeline::Loop::PingPong:
+                    out = std::max(out, std::min(rangeSeconds, cacheSeconds) / 2.0);
+                    break;
+                case tl::timeline::Loop::Loop:
+                    if (rangeSeconds < cacheSeconds)
+                    {
+                        out = std::max(out, rangeSeconds);
+                    }
+                    break;
+                default: break;
+                }
+                out = std::min(out, rangeSeconds);
+            }
+            return std::round(out * readBehindRound) / readBehindRound;
+        }
+
+        struct ReadAheadModel::Private
+        {
+            std::shared_ptr<SettingsModel> settingsModel;
+            std::shared_ptr<CacheModel> cacheModel;
+            std::shared_ptr<tl::timeline::Player> player;
+            float videoGB = 0.F;
+            size_t frameByteCount = 0;
+
+            std::shared_ptr<feather_tk::ObservableValue<double> > readBehind;
+
+            std::shared_ptr<feather_tk::ValueObserver<ReadAheadSettings> > settingsObserver;
+            std::shared_ptr<feather_tk::ValueObserver<tl::timeline::PlayerCacheOptions> > cacheOptionsObserver;
+            std::shared_ptr<feather_tk::ValueObserver<tl::timeline::Loop> > loopObserver;
+            std::shared_ptr<feather_tk::ValueObserver<double> > speedObserver;
+            std::shared_ptr<feather_tk::ValueObserver<OTIO_NS::TimeRange> > inOutRangeObserver;
+            std::shared_ptr<feather_tk::ListObserver<tl::timeline::VideoData> > videoObserver;
+        };
+
+        void ReadAheadModel::_init(
+            const std::shared_ptr<feather_tk::Context>&,
+            const std::shared_ptr<SettingsModel>& settingsModel,
+            const std::shared_ptr<CacheModel>& cacheModel)
+        {
+            FEATHER_TK_P();
+
+            p.settingsModel = settingsModel;
+            p.cacheModel = cacheModel;
+
+            p.readBehind = feather_tk::ObservableValue<double>::create(
+                cacheModel->getCacheOptions().readBehind);
+
+            p.settingsObserver = feather_tk::ValueObserver<ReadAheadSettings>::create(
+                settingsModel->observeReadAhead(),
+                [this](const ReadAheadSettings&)
+                {
+                    _update();
+                });
+
+            p.cacheOptionsObserver = feather_tk::ValueObserver<tl::timeline::PlayerCacheOptions>::create(
+                cacheModel->observeCacheOptions(),
+                [this](const tl::timeline::PlayerCacheOptions&)
+                {
+                    _update();
+                });
+        }
+
+        ReadAheadModel::ReadAheadModel() :
+            _p(new Private)
+        {}
+
+        ReadAheadModel::~ReadAheadModel()
+        {}
+
+        std::shared_ptr<ReadAheadModel> ReadAheadModel::create(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<SettingsModel>& settingsModel,
+            const std::shared_ptr<CacheModel>& cacheModel)
+        {
+            auto out = std::shared_ptr<ReadAheadModel>(new ReadAheadModel);
+            out->_init(context, settingsModel, cacheModel);
+            return out;
+        }
+
+        void ReadAheadModel::setPlayer(const std::shared_ptr<tl::timeline::Player>& value)
+        {
+            FEATHER_TK_P();
+            if (value != p.player)
+            {
+                p.player = value;
+                _playerUpdate();
+            }
+        }
+
+        void ReadAheadModel::setVideoGB(float value)
+        {
+            FEATHER_TK_P();
+            if (value != p.videoGB)
+            {
+                p.videoGB = value;
+                _update();
+            }
+        }
+
+        double ReadAheadModel::getReadBehind() const
+        {
+            return _p->readBehind->get();
+        }
+
+        std::shared_ptr<feather_tk::IObservableValue<double> > ReadAheadModel::observeReadBehind() const
+        {
+            return _p->readBehind;
+        }
+
+        void ReadAheadModel::_playerUpdate()
+        {
+            FEATHER_TK_P();
+
+            p.loopObserver.reset();
+            p.speedObserver.reset();
+            p.inOutRangeObserver.reset();
+            p.videoObserver.reset();
+
+            p.frameByteCount = 0;
+
+            if (p.player)
+            {
+                p.loopObserver = feather_tk::ValueObserver<tl::timeline::Loop>::create(
+                    p.player->observeLoop(),
+                    [this](tl::timeline::Loop)
+                    {
+                        _update();
+                    });
+
+                p.speedObserver = feather_tk::ValueObserver<double>::create(
+                    p.player->observeSpeed(),
+                    [this](double)
+                    {
+                        _update();
+                    });
+
+                p.inOutRangeObserver = feather_tk::ValueObserver<OTIO_NS::TimeRange>::create(
+                    p.player->observeInOutRange(),
+                    [this](const OTIO_NS::TimeRange&)
+                    {
+                        _update();
+                    });
+
+                p.videoObserver = feather_tk::ListObserver<tl::timeline::VideoData>::create(
+                    p.player->observeCurrentVideo(),
+                    [this](const std::vector<tl::timeline::VideoData>& value)
+                    {
+                        // The size of the frames is used to estimate how
+                        // many seconds fit in the video cache.
+                        FEATHER_TK_P();
+                        size_t byteCount = 0;
+                        for (const auto& video : value)
+                        {
+                            for (const auto& layer : video.layers)
+                            {
+                                if (layer.image)
+                                {
+                                    byteCount += layer.image->getByteCount();
+                                }
+                                if (layer.imageB)
+                                {
+                                    byteCount += layer.imageB->getByteCount();
+                                }
+                            }
+                        }
+                        if (byteCount > 0 && byteCount != p.frameByteCount)
+                        {
+                            p.frameByteCount = byteCount;
+                            _update();
+                        }
+                    });
+            }
+
+            _update();
+        }
+
+        void ReadAheadModel::_update()
+        {
+            FEATHER_TK_P();
+            double readBehind = p.cacheModel->getCacheOptions().readBehind;
+            if (p.settingsModel->getReadAhead().enabled && p.player)
+            {
+                // Estimate how many seconds fit in the video cache.
+                const double defaultSpeed = p.player->getDefaultSpeed();
+                double cacheSeconds = 0.0;
+                if (p.frameByteCount > 0 && defaultSpeed > 0.0)
+                {
+                    cacheSeconds = p.videoGB * 1024.0 * 1024.0 * 1024.0 /
+                        (p.frameByteCount * defaultSpeed);
+                }
+                readBehind = getReadBehind(
+                    readBehind,
+                    p.player->observeSpeed()->get(),
+                    defaultSpeed,
+                    p.player->observeLoop()->get(),
+                    p.player->observeInOutRange()->get().duration().rescaled_to(1.0).value(),
+                    cacheSeconds);
+            }
+            p.readBehind->setIfChanged(readBehind);
+        }
+    }
+}
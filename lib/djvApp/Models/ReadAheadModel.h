@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/Player.h>
+
+#include <feather-tk/core/ObservableValue.h>
+
+namespace feather_tk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        class CacheModel;
+        class SettingsModel;
+
+        //! Get the read behind in seconds from the playback state. The in/out
+        //! range and the video cache are given in seconds, zero means that
+        //! they are not known.
+        double getReadBehind(
+            double readBehind,
+            double speed,
+            double defaultSpeed,
+            tl::timeline::Loop,
+            double rangeSeconds,
+            double cacheSeconds);
+
+        //! Read ahead model.
+        //!
+        //! This model computes the read behind used by the current player
+        //! from the playback state. The read behind is scaled by the speed
+        //! multiplier, so that the same number of frames are kept at higher
+        //! speeds. With ping-pong playback half of the video cache is kept
+        //! behind the current time, so the frames are still cached after the
+        //! playback changes direction. With loop playback the whole in/out
+        //! range is kept when it fits in the video cache, so the frames are
+        //! still cached when the playback wraps around.
+        class ReadAheadModel : public std::enable_shared_from_this<ReadAheadModel>
+        {
+            FEATHER_TK_NON_COPYABLE(ReadAheadModel);
+
+        protected:
+            void _init(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<SettingsModel>&,
+                const std::shared_ptr<CacheModel>&);
+
+            ReadAheadModel();
+
+        public:
+            ~ReadAheadModel();
+
+            //! Create a new model.
+            static std::shared_ptr<ReadAheadModel> create(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<SettingsModel>&,
+                const std::shared_ptr<CacheModel>&);
+
+            //! Set the current player.
+            void setPlayer(const std::shared_ptr<tl::timeline::Player>&);
+
+            //! Set the size of the video cache used by the current player in
+            //! gigabytes.
+            void setVideoGB(float);
+
+            //! Get the read behind in seconds.
+            double getReadBehind() const;
+
+            //! Observe the read behind in seconds.
+            std::shared_ptr<feather_tk::IObservableValue<double> > observeReadBehind() const;
+
+        private:
+            void _playerUpdate();
+            void _update();
+
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
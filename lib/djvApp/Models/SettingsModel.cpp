@@ -28,6 +28,20 @@ namespace djv
             return !(*this == other);
         }
 
+        bool AutoCacheSettings::operator == (const AutoCacheSettings& other) const
+        {
+            return
+                enabled == other.enabled &&
+                percentage == other.percentage &&
+                minGB == other.minGB &&
+                maxGB == other.maxGB;
+        }
+
+        bool AutoCacheSettings::operator != (const AutoCacheSettings& other) const
+        {
+            return !(*this == other);
+        }
+
         FEATHER_TK_ENUM_IMPL(
             ExportRenderSize,
             "Default",
@@ -214,8 +228,14 @@ namespace djv
                 Shortcut("View/AlphaBlendNone", "Alpha blend none"),
                 Shortcut("View/AlphaBlendStraight", "Alpha blend straight"),
                 Shortcut("View/AlphaBlendPremultiplied", "Alpha blend premultiplied"),
+                Shortcut("View/Proxy", "USD proxy", feather_tk::Key::P),
+                Shortcut("View/ProxyHalf", "USD proxy 1/2"),
+                Shortcut("View/ProxyQuarter", "USD proxy 1/4"),
+                Shortcut("View/ProxyEighth", "USD proxy 1/8"),
                 Shortcut("View/Grid", "Grid", feather_tk::Key::G, static_cast<int>(feather_tk::KeyModifier::Control)),
                 Shortcut("View/HUD", "HUD", feather_tk::Key::H, static_cast<int>(feather_tk::KeyModifier::Control)),
+                Shortcut("View/FrameGraph", "Frame graph"),
+                Shortcut("View/FrameTiming", "Write frame timing"),
 
                 Shortcut("Window/FullScreen", "Full screen", feather_tk::Key::U),
                 Shortcut("Window/FloatOnTop", "Float on top"),
@@ -295,6 +315,40 @@ namespace djv
             return !(*this == other);
         }
 
+        bool PlayerPoolSettings::operator == (const PlayerPoolSettings& other) const
+        {
+            return
+                count == other.count &&
+                percentage == other.percentage;
+        }
+
+        bool PlayerPoolSettings::operator != (const PlayerPoolSettings& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool ReadAheadSettings::operator == (const ReadAheadSettings& other) const
+        {
+            return enabled == other.enabled;
+        }
+
+        bool ReadAheadSettings::operator != (const ReadAheadSettings& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool SharedCacheSettings::operator == (const SharedCacheSettings& other) const
+        {
+            return
+                enabled == other.enabled &&
+                maxGB == other.maxGB;
+        }
+
+        bool SharedCacheSettings::operator != (const SharedCacheSettings& other) const
+        {
+            return !(*this == other);
+        }
+
         bool StyleSettings::operator == (const StyleSettings& other) const
         {
             return
@@ -386,6 +440,10 @@ namespace djv
 
             std::shared_ptr<feather_tk::ObservableValue<AdvancedSettings> > advanced;
             std::shared_ptr<feather_tk::ObservableValue<tl::timeline::PlayerCacheOptions> > cache;
+            std::shared_ptr<feather_tk::ObservableValue<AutoCacheSettings> > autoCache;
+            std::shared_ptr<feather_tk::ObservableValue<PlayerPoolSettings> > playerPool;
+            std::shared_ptr<feather_tk::ObservableValue<ReadAheadSettings> > readAhead;
+            std::shared_ptr<feather_tk::ObservableValue<SharedCacheSettings> > sharedCache;
             std::shared_ptr<feather_tk::ObservableValue<ExportSettings> > exportSettings;
             std::shared_ptr<feather_tk::ObservableValue<FileBrowserSettings> > fileBrowser;
             std::shared_ptr<feather_tk::ObservableValue<ImageSequenceSettings> > imageSequence;
@@ -420,6 +478,22 @@ namespace djv
             settings->getT("/Cache", cache);
             p.cache = feather_tk::ObservableValue<tl::timeline::PlayerCacheOptions>::create(cache);
 
+            AutoCacheSettings autoCache;
+            settings->getT("/AutoCache", autoCache);
+            p.autoCache = feather_tk::ObservableValue<AutoCacheSettings>::create(autoCache);
+
+            PlayerPoolSettings playerPool;
+            settings->getT("/PlayerPool", playerPool);
+            p.playerPool = feather_tk::ObservableValue<PlayerPoolSettings>::create(playerPool);
+
+            ReadAheadSettings readAhead;
+            settings->getT("/ReadAhead", readAhead);
+            p.readAhead = feather_tk::ObservableValue<ReadAheadSettings>::create(readAhead);
+
+            SharedCacheSettings sharedCache;
+            settings->getT("/SharedCache", sharedCache);
+            p.sharedCache = feather_tk::ObservableValue<SharedCacheSettings>::create(sharedCache);
+
             ExportSettings exportSettings;
             settings->getT("/Export", exportSettings);
             p.exportSettings = feather_tk::ObservableValue<ExportSettings>::create(exportSettings);
@@ -497,6 +571,10 @@ namespace djv
             FEATHER_TK_P();
             p.settings->setT("/Advanced", p.advanced->get());
             p.settings->setT("/Cache", p.cache->get());
+            p.settings->setT("/AutoCache", p.autoCache->get());
+            p.settings->setT("/PlayerPool", p.playerPool->get());
+            p.settings->setT("/ReadAhead", p.readAhead->get());
+            p.settings->setT("/SharedCache", p.sharedCache->get());
             p.settings->setT("/Export", p.exportSettings->get());
 
             FileBrowserSettings fileBrowser = p.fileBrowser->get();
@@ -531,6 +609,10 @@ namespace djv
         {
             setAdvanced(AdvancedSettings());
             setCache(tl::timeline::PlayerCacheOptions());
+            setAutoCache(AutoCacheSettings());
+            setPlayerPool(PlayerPoolSettings());
+            setReadAhead(ReadAheadSettings());
+            setSharedCache(SharedCacheSettings());
             setExport(ExportSettings());
             setFileBrowser(FileBrowserSettings());
             setImageSequence(ImageSequenceSettings());
@@ -580,6 +662,66 @@ namespace djv
             _p->cache->setIfChanged(value);
         }
 
+        const AutoCacheSettings& SettingsModel::getAutoCache() const
+        {
+            return _p->autoCache->get();
+        }
+
+        std::shared_ptr<feather_tk::IObservableValue<AutoCacheSettings> > SettingsModel::observeAutoCache() const
+        {
+            return _p->autoCache;
+        }
+
+        void SettingsModel::setAutoCache(const AutoCacheSettings& value)
+        {
+            _p->autoCache->setIfChanged(value);
+        }
+
+        const PlayerPoolSettings& SettingsModel::getPlayerPool() const
+        {
+            return _p->playerPool->get();
+        }
+
+        std::shared_ptr<feather_tk::IObservableValue<PlayerPoolSettings> > SettingsModel::observePlayerPool() const
+        {
+            return _p->playerPool;
+        }
+
+        void SettingsModel::setPlayerPool(const PlayerPoolSettings& value)
+        {
+            _p->playerPool->setIfChanged(value);
+        }
+
+        const ReadAheadSettings& SettingsModel::getReadAhead() const
+        {
+            return _p->readAhead->get();
+        }
+
+        std::shared_ptr<feather_tk::IObservableValue<ReadAheadSettings> > SettingsModel::observeReadAhead() const
+        {
+            return _p->readAhead;
+        }
+
+        void SettingsModel::setReadAhead(const ReadAheadSettings& value)
+        {
+            _p->readAhead->setIfChanged(value);
+        }
+
+        const SharedCacheSettings& SettingsModel::getSharedCache() const
+        {
+            return _p->sharedCache->get();
+        }
+
+        std::shared_ptr<feather_tk::IObservableValue<SharedCacheSettings> > SettingsModel::observeSharedCache() const
+        {
+            return _p->sharedCache;
+        }
+
+        void SettingsModel::setSharedCache(const SharedCacheSettings& value)
+        {
+            _p->sharedCache->setIfChanged(value);
+        }
+
         const ExportSettings& SettingsModel::getExport() const
         {
             return _p->exportSettings->get();
@@ -765,6 +907,14 @@ namespace djv
             json["AudioRequestMax"] = value.audioRequestMax;
         }
 
+        void to_json(nlohmann::json& json, const AutoCacheSettings& value)
+        {
+            json["Enabled"] = value.enabled;
+            json["Percentage"] = value.percentage;
+            json["MinGB"] = value.minGB;
+            json["MaxGB"] = value.maxGB;
+        }
+
         void to_json(nlohmann::json& json, const ExportSettings& value)
         {
             json["Directory"] = value.directory;
@@ -825,6 +975,23 @@ namespace djv
             json["WheelScale"] = value.wheelScale;
         }
 
+        void to_json(nlohmann::json& json, const PlayerPoolSettings& value)
+        {
+            json["Count"] = value.count;
+            json["Percentage"] = value.percentage;
+        }
+
+        void to_json(nlohmann::json& json, const ReadAheadSettings& value)
+        {
+            json["Enabled"] = value.enabled;
+        }
+
+        void to_json(nlohmann::json& json, const SharedCacheSettings& value)
+        {
+            json["Enabled"] = value.enabled;
+            json["MaxGB"] = value.maxGB;
+        }
+
         void to_json(nlohmann::json& json, const StyleSettings& value)
         {
             json["DisplayScale"] = value.displayScale;
@@ -874,6 +1041,14 @@ namespace djv
             json.at("AudioRequestMax").get_to(value.audioRequestMax);
         }
 
+        void from_json(const nlohmann::json& json, AutoCacheSettings& value)
+        {
+            json.at("Enabled").get_to(value.enabled);
+            json.at("Percentage").get_to(value.percentage);
+            json.at("MinGB").get_to(value.minGB);
+            json.at("MaxGB").get_to(value.maxGB);
+        }
+
         void from_json(const nlohmann::json& json, ExportSettings& value)
         {
             json.at("Directory").get_to(value.directory);
@@ -928,6 +1103,23 @@ namespace djv
             json.at("WheelScale").get_to(value.wheelScale);
         }
 
+        void from_json(const nlohmann::json& json, PlayerPoolSettings& value)
+        {
+            json.at("Count").get_to(value.count);
+            json.at("Percentage").get_to(value.percentage);
+        }
+
+        void from_json(const nlohmann::json& json, ReadAheadSettings& value)
+        {
+            json.at("Enabled").get_to(value.enabled);
+        }
+
+        void from_json(const nlohmann::json& json, SharedCacheSettings& value)
+        {
+            json.at("Enabled").get_to(value.enabled);
+            json.at("MaxGB").get_to(value.maxGB);
+        }
+
         void from_json(const nlohmann::json& json, ShortcutsSettings& value)
         {
             for (auto i = json.at("Shortcuts").begin(); i != json.at("Shortcuts").end(); ++i)
@@ -46,6 +46,26 @@ namespace djv
             bool operator != (const AdvancedSettings&) const;
         };
 
+        //! Automatic cache settings.
+        struct AutoCacheSettings
+        {
+            //! Size the video cache from the available system memory.
+            bool enabled = false;
+
+            //! Percentage of the available memory used for the video cache.
+            float percentage = 50.F;
+
+            //! Minimum video cache size in gigabytes.
+            float minGB = 1.F;
+
+            //! Maximum video cache size in gigabytes. A value of zero
+            //! disables the maximum.
+            float maxGB = 0.F;
+
+            bool operator == (const AutoCacheSettings&) const;
+            bool operator != (const AutoCacheSettings&) const;
+        };
+
         //! Export render size.
         enum class ExportRenderSize
         {
@@ -175,6 +195,49 @@ namespace djv
             bool operator != (const MouseSettings&) const;
         };
 
+        //! Player pool settings.
+        //!
+        //! Players for recently viewed files are kept in a pool so that
+        //! switching back to them shows the cached frames immediately.
+        struct PlayerPoolSettings
+        {
+            //! The maximum number of players kept in the pool.
+            size_t count = 4;
+
+            //! The percentage of the video cache shared by the players in
+            //! the pool.
+            float percentage = 50.F;
+
+            bool operator == (const PlayerPoolSettings&) const;
+            bool operator != (const PlayerPoolSettings&) const;
+        };
+
+        //! Read ahead settings.
+        struct ReadAheadSettings
+        {
+            //! Adjust the read behind from the playback speed and loop
+            //! mode.
+            bool enabled = true;
+
+            bool operator == (const ReadAheadSettings&) const;
+            bool operator != (const ReadAheadSettings&) const;
+        };
+
+        //! Shared cache settings.
+        struct SharedCacheSettings
+        {
+            //! Share decoded frames with other instances of the
+            //! application through shared memory.
+            bool enabled = false;
+
+            //! Maximum shared cache size in gigabytes. The size is set by
+            //! the first instance that creates the cache.
+            float maxGB = 4.F;
+
+            bool operator == (const SharedCacheSettings&) const;
+            bool operator != (const SharedCacheSettings&) const;
+        };
+
         //! Keyboard shortcuts settings.
         struct ShortcutsSettings
         {
@@ -294,6 +357,22 @@ namespace djv
             std::shared_ptr<feather_tk::IObservableValue<tl::timeline::PlayerCacheOptions> > observeCache() const;
             void setCache(const tl::timeline::PlayerCacheOptions&);
 
+            const AutoCacheSettings& getAutoCache() const;
+            std::shared_ptr<feather_tk::IObservableValue<AutoCacheSettings> > observeAutoCache() const;
+            void setAutoCache(const AutoCacheSettings&);
+
+            const PlayerPoolSettings& getPlayerPool() const;
+            std::shared_ptr<feather_tk::IObservableValue<PlayerPoolSettings> > observePlayerPool() const;
+            void setPlayerPool(const PlayerPoolSettings&);
+
+            const ReadAheadSettings& getReadAhead() const;
+            std::shared_ptr<feather_tk::IObservableValue<ReadAheadSettings> > observeReadAhead() const;
+            void setReadAhead(const ReadAheadSettings&);
+
+            const SharedCacheSettings& getSharedCache() const;
+            std::shared_ptr<feather_tk::IObservableValue<SharedCacheSettings> > observeSharedCache() const;
+            void setSharedCache(const SharedCacheSettings&);
+
             ///@}
 
             //! \name Export
@@ -407,24 +486,32 @@ namespace djv
         ///@{
 
         void to_json(nlohmann::json&, const AdvancedSettings&);
+        void to_json(nlohmann::json&, const AutoCacheSettings&);
         void to_json(nlohmann::json&, const ExportSettings&);
         void to_json(nlohmann::json&, const FileBrowserSettings&);
         void to_json(nlohmann::json&, const ImageSequenceSettings&);
         void to_json(nlohmann::json&, const MiscSettings&);
         void to_json(nlohmann::json&, const MouseActionBinding&);
         void to_json(nlohmann::json&, const MouseSettings&);
+        void to_json(nlohmann::json&, const PlayerPoolSettings&);
+        void to_json(nlohmann::json&, const ReadAheadSettings&);
+        void to_json(nlohmann::json&, const SharedCacheSettings&);
         void to_json(nlohmann::json&, const ShortcutsSettings&);
         void to_json(nlohmann::json&, const StyleSettings&);
         void to_json(nlohmann::json&, const TimelineSettings&);
         void to_json(nlohmann::json&, const WindowSettings&);
 
         void from_json(const nlohmann::json&, AdvancedSettings&);
+        void from_json(const nlohmann::json&, AutoCacheSettings&);
         void from_json(const nlohmann::json&, ExportSettings&);
         void from_json(const nlohmann::json&, FileBrowserSettings&);
         void from_json(const nlohmann::json&, ImageSequenceSettings&);
         void from_json(const nlohmann::json&, MiscSettings&);
         void from_json(const nlohmann::json&, MouseActionBinding&);
         void from_json(const nlohmann::json&, MouseSettings&);
+        void from_json(const nlohmann::json&, PlayerPoolSettings&);
+        void from_json(const nlohmann::json&, ReadAheadSettings&);
+        void from_json(const nlohmann::json&, SharedCacheSettings&);
         void from_json(const nlohmann::json&, ShortcutsSettings&);
         void from_json(const nlohmann::json&, StyleSettings&);
         void from_json(const nlohmann::json&, TimelineSettings&);
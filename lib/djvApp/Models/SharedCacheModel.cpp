@@ -0,0 +1,695 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Models/SharedCacheModel.h>
+
+#include <djvApp/Models/SettingsModel.h>
+
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/Format.h>
+
+#if !defined(_WINDOWS)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if !defined(__APPLE__)
+#include <sys/statvfs.h>
+#endif // __APPLE__
+#include <unistd.h>
+#endif // _WINDOWS
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            static_assert(std::atomic<uint64_t>::is_always_lock_free);
+            static_assert(std::atomic<uint32_t>::is_always_lock_free);
+            static_assert(std::atomic<int64_t>::is_always_lock_free);
+
+            //! The number of slots in the index.
+            const uint64_t slotCount = 65536;
+
+            //! The alignment of the records in the buffer.
+            const uint64_t recordAlignment = 64;
+
+            //! How long to wait for another instance to create the shared
+            //! memory.
+            const std::chrono::milliseconds readyTimeout(1000);
+
+            //! The number of attempts to open the shared memory.
+            const size_t openAttempts = 3;
+
+            //! The maximum number of instances that can be attached to the
+            //! shared memory.
+            const size_t processMax = 64;
+
+            //! The maximum number of frames waiting to be written.
+            const size_t writeQueueMax = 16;
+
+            const std::chrono::milliseconds timeout(100);
+
+            //! The segment starts with a header, followed by the index
+            //! and the circular buffer. The process IDs of the attached
+            //! instances are stored in the header, so that instances that
+            //! have crashed can be found.
+            struct SegmentHeader
+            {
+                std::atomic<uint32_t> ready;
+                uint32_t version = 2;
+                uint64_t capacity = 0;
+                std::atomic<uint64_t> writePos;
+                std::atomic<int64_t> processes[processMax];
+            };
+
+            //! An index slot. The sequence number is odd while the slot is
+            //! being written.
+            struct Slot
+            {
+                std::atomic<uint64_t> seq;
+                std::atomic<uint64_t> hash;
+                std::atomic<uint64_t> offset;
+                std::atomic<uint64_t> size;
+            };
+
+            //! A record in the circular buffer, followed by the key and the
+            //! image data.
+            struct RecordHeader
+            {
+                uint32_t keySize = 0;
+                int32_t width = 0;
+                int32_t height = 0;
+                int32_t type = 0;
+                float pixelAspectRatio = 1.F;
+                int32_t videoLevels = 0;
+                uint8_t mirrorX = 0;
+                uint8_t mirrorY = 0;
+                uint8_t alignment = 1;
+                uint8_t endian = 0;
+                int32_t videoWidth = 0;
+                int32_t videoHeight = 0;
+                double timeValue = 0.0;
+                double timeRate = 0.0;
+                uint64_t dataSize = 0;
+            };
+
+            uint64_t align(uint64_t value, uint64_t alignment)
+            {
+                return (value + alignment - 1) / alignment * alignment;
+            }
+
+            const uint64_t slotsOffset = align(sizeof(SegmentHeader), recordAlignment);
+            const uint64_t bufferOffset = align(slotsOffset + slotCount * sizeof(Slot), 4096);
+
+            uint64_t getHash(const std::string& key)
+            {
+                // FNV-1a hash.
+                uint64_t hash = 14695981039346656037ULL;
+                for (const char c : key)
+                {
+                    hash ^= static_cast<uint8_t>(c);
+                    hash *= 1099511628211ULL;
+                }
+                return hash;
+            }
+
+            bool isCacheable(const tl::timeline::VideoData& value)
+            {
+                return
+                    1 == value.layers.size() &&
+                    value.layers.front().image &&
+                    !value.layers.front().imageB;
+            }
+
+#if !defined(_WINDOWS)
+            bool isProcessRunning(int64_t pid)
+            {
+                return 0 == kill(static_cast<pid_t>(pid), 0) || EPERM == errno;
+            }
+#endif // _WINDOWS
+
+            std::string getName()
+            {
+                std::string out = "/djv-cache";
+#if !defined(_WINDOWS)
+                // The shared memory is not shared between users.
+                out += "-" + std::to_string(getuid());
+#endif // _WINDOWS
+                return out;
+            }
+
+            //! Shared memory segment.
+            class Segment
+            {
+            public:
+                Segment(const std::string& name, uint64_t capacity) :
+                    _name(name)
+                {
+#if !defined(_WINDOWS)
+                    // Opening the segment is retried, since another instance
+                    // may be creating it or removing it at the same time.
+                    for (size_t i = 0; i < openAttempts && !_header; ++i)
+                    {
+                        _open(capacity);
+                    }
+                    if (_header)
+                    {
+                        _attach();
+                        _slots = reinterpret_cast<Slot*>(_data + slotsOffset);
+                        _buffer = _data + bufferOffset;
+                    }
+#else // _WINDOWS
+                    _error = "Shared memory is not supported";
+#endif // _WINDOWS
+                }
+
+                ~Segment()
+                {
+#if !defined(_WINDOWS)
+                    if (_header && _detach())
+                    {
+                        shm_unlink(_name.c_str());
+                    }
+                    _unmap();
+#endif // _WINDOWS
+                }
+
+                bool isValid() const
+                {
+                    return _header;
+                }
+
+                const std::string& getError() const
+                {
+                    return _error;
+                }
+
+                uint64_t getCapacity() const
+                {
+                    return _header ? _header->capacity : 0;
+                }
+
+                bool get(const std::string& key, tl::timeline::VideoData& value)
+                {
+                    bool out = false;
+                    const uint64_t hash = getHash(key);
+                    Slot& slot = _slots[hash % slotCount];
+                    const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+                    const uint64_t slotHash = slot.hash.load(std::memory_order_relaxed);
+                    const uint64_t offset = slot.offset.load(std::memory_order_relaxed);
+                    const uint64_t size = slot.size.load(std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    const uint64_t capacity = _header->capacity;
+                    if (0 == (seq & 1) &&
+                        seq == slot.seq.load(std::memory_order_relaxed) &&
+                        hash == slotHash &&
+                        size >= sizeof(RecordHeader) &&
+                        size <= capacity &&
+                        _isValid(offset))
+                    {
+                        const uint8_t* data = _buffer + offset % capacity;
+                        RecordHeader header;
+                        memcpy(&header, data, sizeof(RecordHeader));
+                        if (sizeof(RecordHeader) + header.keySize + header.dataSize <= size &&
+                            0 == key.compare(
+                                0,
+                                std::string::npos,
+                                reinterpret_cast<const char*>(data + sizeof(RecordHeader)),
+                                header.keySize))
+                        {
+                            feather_tk::ImageInfo info(
+                                feather_tk::Size2I(header.width, header.height),
+                                static_cast<feather_tk::ImageType>(header.type));
+                            info.pixelAspectRatio = header.pixelAspectRatio;
+                            info.videoLevels = static_cast<feather_tk::VideoLevels>(header.videoLevels);
+                            info.layout.mirror.x = header.mirrorX;
+                            info.layout.mirror.y = header.mirrorY;
+                            info.layout.alignment = header.alignment;
+                            info.layout.endian = static_cast<feather_tk::Endian>(header.endian);
+                            auto image = feather_tk::Image::create(info);
+                            if (image->getByteCount() == header.dataSize)
+                            {
+                                memcpy(
+                                    image->getData(),
+                                    data + sizeof(RecordHeader) + header.keySize,
+                                    header.dataSize);
+
+                                // Check that the record was not overwritten
+                                // while it was copied.
+                                std::atomic_thread_fence(std::memory_order_acquire);
+                                if (_isValid(offset))
+                                {
+                                    value = tl::timeline::VideoData();
+                                    value.size = feather_tk::Size2I(header.videoWidth, header.videoHeight);
+                                    value.time = OTIO_NS::RationalTime(header.timeValue, header.timeRate);
+                                    tl::timeline::VideoLayer layer;
+                                    layer.image = image;
+                                    value.layers.push_back(layer);
+                                    out = true;
+                                }
+                            }
+                        }
+                    }
+                    return out;
+                }
+
+                void add(const std::string& key, const tl::timeline::VideoData& value)
+                {
+                    const auto& image = value.layers.front().image;
+                    const feather_tk::ImageInfo& info = image->getInfo();
+                    RecordHeader header;
+                    header.keySize = static_cast<uint32_t>(key.size());
+                    header.width = info.size.w;
+                    header.height = info.size.h;
+                    header.type = static_cast<int32_t>(info.type);
+                    header.pixelAspectRatio = info.pixelAspectRatio;
+                    header.videoLevels = static_cast<int32_t>(info.videoLevels);
+                    header.mirrorX = info.layout.mirror.x;
+                    header.mirrorY = info.layout.mirror.y;
+                    header.alignment = static_cast<uint8_t>(info.layout.alignment);
+                    header.endian = static_cast<uint8_t>(info.layout.endian);
+                    header.videoWidth = value.size.w;
+                    header.videoHeight = value.size.h;
+                    header.timeValue = value.time.value();
+                    header.timeRate = value.time.rate();
+                    header.dataSize = image->getByteCount();
+
+                    // Frames larger than half of the buffer would displace
+                    // too many other frames.
+                    const uint64_t capacity = _header->capacity;
+                    const uint64_t size = align(
+                        sizeof(RecordHeader) + header.keySize + header.dataSize,
+                        recordAlignment);
+                    if (size <= capacity / 2)
+                    {
+                        // Reserve space in the buffer. Records do not wrap
+                        // around the end of the buffer.
+                        uint64_t pos = _header->writePos.load(std::memory_order_relaxed);
+                        uint64_t offset = 0;
+                        do
+                        {
+                            offset = pos;
+                            if (offset % capacity + size > capacity)
+                            {
+                                offset += capacity - offset % capacity;
+                            }
+                        } while (!_header->writePos.compare_exchange_weak(
+                            pos,
+                            offset + size,
+                            std::memory_order_acq_rel));
+
+                        uint8_t* data = _buffer + offset % capacity;
+                        memcpy(data, &header, sizeof(RecordHeader));
+                        memcpy(data + sizeof(RecordHeader), key.data(), header.keySize);
+                        memcpy(data + sizeof(RecordHeader) + header.keySize, image->getData(), header.dataSize);
+
+                        // Publish the record in the index. If another
+                        // writer has the slot the record is not indexed.
+                        Slot& slot = _slots[getHash(key) % slotCount];
+                        uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+                        if (0 == (seq & 1) &&
+                            slot.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire))
+                        {
+                            slot.hash.store(getHash(key), std::memory_order_relaxed);
+                            slot.offset.store(offset, std::memory_order_relaxed);
+                            slot.size.store(size, std::memory_order_relaxed);
+                            slot.seq.store(seq + 2, std::memory_order_release);
+                        }
+                    }
+                }
+
+            private:
+#if !defined(_WINDOWS)
+                void _open(uint64_t capacity)
+                {
+                    int fd = shm_open(_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+                    if (fd != -1)
+                    {
+#if !defined(__APPLE__)
+                        // Shared memory that is not backed by the file
+                        // system causes a bus error when it is written,
+                        // so the size is limited to the available space.
+                        struct statvfs info;
+                        if (0 == statvfs("/dev/shm", &info))
+                        {
+                            capacity = std::min(
+                                capacity,
+                                static_cast<uint64_t>(info.f_bavail) * info.f_frsize / 10 * 9);
+                        }
+#endif // __APPLE__
+                        capacity = capacity / recordAlignment * recordAlignment;
+                        const uint64_t size = bufferOffset + capacity;
+                        if (capacity > 0 &&
+                            0 == ftruncate(fd, size) &&
+                            _map(fd, size))
+                        {
+                            // The memory is initialized to zero, the atomics
+                            // are constructed before the segment is marked
+                            // as ready.
+                            _header = new (_data) SegmentHeader;
+                            _header->capacity = capacity;
+                            _header->writePos = 0;
+                            for (size_t i = 0; i < processMax; ++i)
+                            {
+                                _header->processes[i] = 0;
+                            }
+                            _header->ready.store(1, std::memory_order_release);
+                        }
+                        else
+                        {
+                            _error = "Cannot allocate the shared memory";
+                            shm_unlink(_name.c_str());
+                        }
+                    }
+                    else if (EEXIST == errno)
+                    {
+                        // Wait for the instance that created the segment to
+                        // set the size.
+                        fd = shm_open(_name.c_str(), O_RDWR, 0600);
+                        struct stat info;
+                        bool sized = false;
+                        const auto start = std::chrono::steady_clock::now();
+                        while (fd != -1 &&
+                            !sized &&
+                            std::chrono::steady_clock::now() - start < readyTimeout)
+                        {
+                            sized =
+                                0 == fstat(fd, &info) &&
+                                info.st_size > static_cast<off_t>(bufferOffset);
+                            if (!sized)
+                            {
+                                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                            }
+                        }
+                        if (sized && _map(fd, info.st_size))
+                        {
+                            _header = reinterpret_cast<SegmentHeader*>(_data);
+                            const auto t = std::chrono::steady_clock::now();
+                            while (!_header->ready.load(std::memory_order_acquire) &&
+                                std::chrono::steady_clock::now() - t < readyTimeout)
+                            {
+                                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                            }
+                            if (!_header->ready.load(std::memory_order_acquire) ||
+                                _header->version != SegmentHeader().version ||
+                                bufferOffset + _header->capacity > static_cast<uint64_t>(info.st_size))
+                            {
+                                // The segment was left by an instance that
+                                // crashed or is from a different version,
+                                // it is removed so that the next attempt
+                                // creates a new one.
+                                _error = "The shared memory is not valid";
+                                _unmap();
+                                shm_unlink(_name.c_str());
+                            }
+                        }
+                        else if (fd != -1 && !sized)
+                        {
+                            // The instance that created the segment crashed
+                            // before setting the size.
+                            _error = "Timeout waiting for the shared memory";
+                            shm_unlink(_name.c_str());
+                        }
+                        else
+                        {
+                            _error = "Cannot open the shared memory";
+                        }
+                    }
+                    else
+                    {
+                        _error = std::strerror(errno);
+                    }
+                    if (fd != -1)
+                    {
+                        close(fd);
+                    }
+                }
+
+                bool _map(int fd, uint64_t size)
+                {
+                    void* data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    if (data != MAP_FAILED)
+                    {
+                        _data = static_cast<uint8_t*>(data);
+                        _size = size;
+                    }
+                    return _data;
+                }
+
+                void _attach()
+                {
+                    // Remove the instances that are no longer running, and
+                    // add this instance.
+                    const int64_t pid = getpid();
+                    for (size_t i = 0; i < processMax; ++i)
+                    {
+                        int64_t value = _header->processes[i].load();
+                        if (value != 0 && !isProcessRunning(value))
+                        {
+                            _header->processes[i].compare_exchange_strong(value, 0);
+                        }
+                    }
+                    for (size_t i = 0; i < processMax && -1 == _process; ++i)
+                    {
+                        int64_t value = 0;
+                        if (_header->processes[i].compare_exchange_strong(value, pid))
+                        {
+                            _process = static_cast<int>(i);
+                        }
+                    }
+                }
+
+                // Returns whether there are no other instances running.
+                bool _detach()
+                {
+                    if (_process != -1)
+                    {
+                        _header->processes[_process].store(0);
+                    }
+                    bool out = _process != -1;
+                    for (size_t i = 0; i < processMax; ++i)
+                    {
+                        const int64_t value = _header->processes[i].load();
+                        if (value != 0 && isProcessRunning(value))
+                        {
+                            out = false;
+                        }
+                    }
+                    return out;
+                }
+
+                void _unmap()
+                {
+                    if (_data)
+                    {
+                        munmap(_data, _size);
+                    }
+                    _data = nullptr;
+                    _size = 0;
+                    _header = nullptr;
+                }
+#endif // _WINDOWS
+
+                // A record is valid until the buffer has wrapped around it.
+                bool _isValid(uint64_t offset) const
+                {
+                    return _header->writePos.load(std::memory_order_acquire) - offset <= _header->capacity;
+                }
+
+                std::string _name;
+                std::string _error;
+                uint8_t* _data = nullptr;
+                uint64_t _size = 0;
+                SegmentHeader* _header = nullptr;
+                Slot* _slots = nullptr;
+                uint8_t* _buffer = nullptr;
+                int _process = -1;
+            };
+        }
+
+        struct SharedCacheModel::Private
+        {
+            std::weak_ptr<feather_tk::Context> context;
+
+            struct Mutex
+            {
+                std::shared_ptr<Segment> segment;
+                std::list<std::pair<std::string, tl::timeline::VideoData> > writeQueue;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+            std::condition_variable cv;
+            std::thread thread;
+            std::atomic<bool> running;
+
+            std::shared_ptr<feather_tk::ValueObserver<SharedCacheSettings> > settingsObserver;
+        };
+
+        void SharedCacheModel::_init(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<SettingsModel>& settingsModel)
+        {
+            FEATHER_TK_P();
+
+            p.context = context;
+
+            p.settingsObserver = feather_tk::ValueObserver<SharedCacheSettings>::create(
+                settingsModel->observeSharedCache(),
+                [this](const SharedCacheSettings& value)
+                {
+                    FEATHER_TK_P();
+                    std::shared_ptr<Segment> segment;
+                    {
+                        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                        segment = p.mutex.segment;
+                        p.mutex.segment.reset();
+                        p.mutex.writeQueue.clear();
+                    }
+
+                    // Detach before attaching, so that the segment is
+                    // recreated if this is the only instance.
+                    segment.reset();
+                    if (value.enabled)
+                    {
+                        segment = std::make_shared<Segment>(
+                            getName(),
+                            static_cast<uint64_t>(value.maxGB * 1024.F * 1024.F * 1024.F));
+                        if (auto context = p.context.lock())
+                        {
+                            if (segment->isValid())
+                            {
+                                context->log(
+                                    "djv::app::SharedCacheModel",
+                                    feather_tk::Format("Shared cache: {0}GB").
+                                    arg(segment->getCapacity() / (1024.F * 1024.F * 1024.F), 2));
+                            }
+                            else
+                            {
+                                context->log(
+                                    "djv::app::SharedCacheModel",
+                                    feather_tk::Format("Cannot open the shared cache: {0}").
+                                    arg(segment->getError()),
+                                    feather_tk::LogType::Error);
+                            }
+                        }
+                        if (!segment->isValid())
+                        {
+                            segment.reset();
+                        }
+                    }
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.mutex.segment = segment;
+                });
+
+            p.running = true;
+            p.thread = std::thread(
+                [this]
+                {
+                    _run();
+                });
+        }
+
+        SharedCacheModel::SharedCacheModel() :
+            _p(new Private)
+        {}
+
+        SharedCacheModel::~SharedCacheModel()
+        {
+            FEATHER_TK_P();
+            p.running = false;
+            p.cv.notify_one();
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+        }
+
+        std::shared_ptr<SharedCacheModel> SharedCacheModel::create(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<SettingsModel>& settingsModel)
+        {
+            auto out = std::shared_ptr<SharedCacheModel>(new SharedCacheModel);
+            out->_init(context, settingsModel);
+            return out;
+        }
+
+        size_t SharedCacheModel::getMax() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex.mutex);
+            return _p->mutex.segment ? _p->mutex.segment->getCapacity() : 0;
+        }
+
+        bool SharedCacheModel::get(const std::string& key, tl::timeline::VideoData& value)
+        {
+            FEATHER_TK_P();
+            std::shared_ptr<Segment> segment;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                segment = p.mutex.segment;
+            }
+            return segment ? segment->get(key, value) : false;
+        }
+
+        void SharedCacheModel::add(const std::string& key, const tl::timeline::VideoData& value)
+        {
+            FEATHER_TK_P();
+            if (isCacheable(value))
+            {
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    if (p.mutex.segment && p.mutex.writeQueue.size() < writeQueueMax)
+                    {
+                        p.mutex.writeQueue.push_back(std::make_pair(key, value));
+                    }
+                }
+                p.cv.notify_one();
+            }
+        }
+
+        void SharedCacheModel::_run()
+        {
+            FEATHER_TK_P();
+            while (p.running)
+            {
+                std::shared_ptr<Segment> segment;
+                std::pair<std::string, tl::timeline::VideoData> write;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    if (p.cv.wait_for(
+                        lock,
+                        timeout,
+                        [this]
+                        {
+                            return !_p->running || !_p->mutex.writeQueue.empty();
+                        }))
+                    {
+                        if (!p.mutex.writeQueue.empty())
+                        {
+                            write = p.mutex.writeQueue.front();
+                            p.mutex.writeQueue.pop_front();
+                        }
+                    }
+                    segment = p.mutex.segment;
+                }
+                if (segment && !write.first.empty())
+                {
+                    segment->add(write.first, write.second);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/Video.h>
+
+#include <feather-tk/core/Util.h>
+
+#include <memory>
+#include <string>
+
+namespace feather_tk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        class SettingsModel;
+
+        //! Shared cache model.
+        //!
+        //! This is an optional tier of the frame cache that stores decoded
+        //! frames in shared memory, so that they can be reused by other
+        //! instances of the application running on the same computer. The
+        //! size of the shared memory is set by the first instance that
+        //! creates it, so the memory used is bounded by a single budget for
+        //! all of the instances.
+        //!
+        //! The frames are written to a circular buffer, and the oldest
+        //! frames are overwritten when the buffer is full. The index of the
+        //! frames is lock free, readers check that a frame was not
+        //! overwritten while it was being copied.
+        //!
+        //! The process IDs of the attached instances are stored in the
+        //! shared memory, and the shared memory is removed when the last
+        //! running instance detaches, also when other instances have
+        //! crashed.
+        //!
+        //! The frames are copied into the shared memory on a separate
+        //! thread. The cache is only used by exports, the players do not
+        //! read from it, so the shared memory is not taken from the video
+        //! cache of the players.
+        //!
+        //! Only frames with a single image are stored. The shared cache is
+        //! not available on Windows.
+        //!
+        //! The cache is thread safe.
+        class SharedCacheModel : public std::enable_shared_from_this<SharedCacheModel>
+        {
+            FEATHER_TK_NON_COPYABLE(SharedCacheModel);
+
+        protected:
+            void _init(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<SettingsModel>&);
+
+            SharedCacheModel();
+
+        public:
+            ~SharedCacheModel();
+
+            //! Create a new model.
+            static std::shared_ptr<SharedCacheModel> create(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<SettingsModel>&);
+
+            //! Get the size of the shared memory in bytes, or zero if the
+            //! shared cache is not enabled.
+            size_t getMax() const;
+
+            //! Get a frame from the cache.
+            bool get(const std::string& key, tl::timeline::VideoData&);
+
+            //! Add a frame to the cache. The frame is queued and copied
+            //! into the shared memory on a separate thread.
+            void add(const std::string& key, const tl::timeline::VideoData&);
+
+        private:
+            void _run();
+
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
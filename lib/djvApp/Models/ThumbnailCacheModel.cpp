@@ -0,0 +1,481 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Models/ThumbnailCacheModel.h>
+
+#include <djvApp/Models/BinaryIO.h>
+
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/Format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            const std::chrono::milliseconds timeout(100);
+
+            //! The maximum size of the store.
+            const size_t sizeMax = 256 * 1024 * 1024;
+
+            //! The maximum number of thumbnails waiting to be written.
+            const size_t writeQueueMax = 256;
+
+            const std::string extension = ".djvthumb";
+
+            //! The file header. The fields are written one at a time in
+            //! little endian byte order, so the files do not depend on the
+            //! padding of the structure or the byte order of the computer.
+            struct FileHeader
+            {
+                char magic[4] = { 'D', 'J', 'V', 'T' };
+                uint32_t version = 2;
+                uint32_t keySize = 0;
+                int32_t width = 0;
+                int32_t height = 0;
+                int32_t type = 0;
+                float pixelAspectRatio = 1.F;
+                uint8_t mirrorX = 0;
+                uint8_t mirrorY = 0;
+                uint8_t alignment = 1;
+                uint8_t endian = 0;
+                uint64_t dataSize = 0;
+            };
+
+            //! The size of the file header in bytes: the magic, six 32-bit
+            //! fields, four 8-bit fields, and one 64-bit field.
+            const size_t fileHeaderSize =
+                4 * sizeof(char) +
+                6 * sizeof(uint32_t) +
+                4 * sizeof(uint8_t) +
+                sizeof(uint64_t);
+
+            void writeFileHeader(BinaryWriter& writer, const FileHeader& header)
+            {
+                writer.write(header.magic, 4);
+                writer.writeU32(header.version);
+                writer.writeU32(header.keySize);
+                writer.writeI32(header.width);
+                writer.writeI32(header.height);
+                writer.writeI32(header.type);
+                writer.writeF32(header.pixelAspectRatio);
+                writer.writeU8(header.mirrorX);
+                writer.writeU8(header.mirrorY);
+                writer.writeU8(header.alignment);
+                writer.writeU8(header.endian);
+                writer.writeU64(header.dataSize);
+            }
+
+            //! Read the file header. Returns false if the header is not
+            //! valid or is from a different version.
+            bool readFileHeader(BinaryReader& reader, FileHeader& header)
+            {
+                char magic[4];
+                reader.read(magic, 4);
+                header.version = reader.readU32();
+                header.keySize = reader.readU32();
+                header.width = reader.readI32();
+                header.height = reader.readI32();
+                header.type = reader.readI32();
+                header.pixelAspectRatio = reader.readF32();
+                header.mirrorX = reader.readU8();
+                header.mirrorY = reader.readU8();
+                header.alignment = reader.readU8();
+                header.endian = reader.readU8();
+                header.dataSize = reader.readU64();
+                return
+                    !reader.hasError() &&
+                    0 == memcmp(magic, FileHeader().magic, 4) &&
+                    FileHeader().version == header.version;
+            }
+
+            std::string getKey(
+                const tl::file::Path& path,
+                int height,
+                const OTIO_NS::RationalTime& time)
+            {
+                const std::string fileName = path.get();
+                int64_t modified = 0;
+                std::error_code ec;
+                const auto lastWriteTime = std::filesystem::last_write_time(
+                    std::filesystem::u8path(fileName),
+                    ec);
+                if (!ec)
+                {
+                    modified = lastWriteTime.time_since_epoch().count();
+                }
+                std::stringstream ss;
+                ss << fileName << ";" << modified << ";" << height << ";" <<
+                    time.value() << "/" << time.rate();
+                return ss.str();
+            }
+
+            std::string getFileName(const std::string& key)
+            {
+                // FNV-1a hash.
+                uint64_t hash = 14695981039346656037ULL;
+                for (const char c : key)
+                {
+                    hash ^= static_cast<uint8_t>(c);
+                    hash *= 1099511628211ULL;
+                }
+                std::stringstream ss;
+                ss << std::hex << std::setfill('0') << std::setw(16) << hash << extension;
+                return ss.str();
+            }
+
+            void writeFile(
+                const std::filesystem::path& path,
+                const std::string& key,
+                const std::shared_ptr<feather_tk::Image>& image)
+            {
+                const feather_tk::ImageInfo& info = image->getInfo();
+                FileHeader header;
+                header.keySize = static_cast<uint32_t>(key.size());
+                header.width = info.size.w;
+                header.height = info.size.h;
+                header.type = static_cast<int32_t>(info.type);
+                header.pixelAspectRatio = info.pixelAspectRatio;
+                header.mirrorX = info.layout.mirror.x;
+                header.mirrorY = info.layout.mirror.y;
+                header.alignment = static_cast<uint8_t>(info.layout.alignment);
+                header.endian = static_cast<uint8_t>(info.layout.endian);
+                header.dataSize = image->getByteCount();
+
+                // Write to a temporary file so that a partial file is never
+                // read.
+                std::filesystem::path tmp = path;
+                tmp += ".tmp";
+                {
+                    std::ofstream file(tmp, std::ios::binary);
+                    if (!file.is_open())
+                    {
+                        throw std::runtime_error(
+                            feather_tk::Format("Cannot open: \"{0}\"").arg(tmp.u8string()));
+                    }
+                    BinaryWriter writer;
+                    writeFileHeader(writer, header);
+                    writer.write(key.data(), key.size());
+                    file.write(reinterpret_cast<const char*>(writer.getData().data()), writer.getData().size());
+                    file.write(reinterpret_cast<const char*>(image->getData()), header.dataSize);
+                    if (!file)
+                    {
+                        throw std::runtime_error(
+                            feather_tk::Format("Cannot write: \"{0}\"").arg(tmp.u8string()));
+                    }
+                }
+                std::filesystem::rename(tmp, path);
+            }
+
+            std::shared_ptr<feather_tk::Image> readFile(
+                const std::filesystem::path& path,
+                const std::string& key)
+            {
+                std::shared_ptr<feather_tk::Image> out;
+                std::ifstream file(path, std::ios::binary);
+                std::vector<uint8_t> data(fileHeaderSize);
+                BinaryReader reader(data.data(), data.size());
+                FileHeader header;
+                std::string fileKey;
+                if (file.is_open() &&
+                    file.read(reinterpret_cast<char*>(data.data()), data.size()) &&
+                    readFileHeader(reader, header) &&
+                    header.keySize == key.size())
+                {
+                    fileKey.resize(header.keySize);
+                    if (file.read(fileKey.data(), header.keySize) && fileKey == key)
+                    {
+                        feather_tk::ImageInfo info(
+                            feather_tk::Size2I(header.width, header.height),
+                            static_cast<feather_tk::ImageType>(header.type));
+                        info.pixelAspectRatio = header.pixelAspectRatio;
+                        info.layout.mirror.x = header.mirrorX;
+                        info.layout.mirror.y = header.mirrorY;
+                        info.layout.alignment = header.alignment;
+                        info.layout.endian = static_cast<feather_tk::Endian>(header.endian);
+                        auto image = feather_tk::Image::create(info);
+                        if (image->getByteCount() == header.dataSize &&
+                            file.read(reinterpret_cast<char*>(image->getData()), header.dataSize))
+                        {
+                            out = image;
+                        }
+                    }
+                }
+                return out;
+            }
+        }
+
+        struct ThumbnailCacheModel::Private
+        {
+            std::weak_ptr<feather_tk::Context> context;
+            std::filesystem::path directory;
+
+            struct Request
+            {
+                tl::file::Path path;
+                int height = 0;
+                OTIO_NS::RationalTime time = tl::time::invalidTime;
+                std::promise<std::shared_ptr<feather_tk::Image> > promise;
+            };
+
+            struct Write
+            {
+                tl::file::Path path;
+                int height = 0;
+                OTIO_NS::RationalTime time = tl::time::invalidTime;
+                std::shared_ptr<feather_tk::Image> image;
+            };
+
+            struct Mutex
+            {
+                std::list<std::shared_ptr<Request> > requests;
+                std::list<Write> writeQueue;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+            std::condition_variable cv;
+            std::thread thread;
+            std::atomic<bool> running;
+
+            void log(const std::string& value)
+            {
+                if (auto context = this->context.lock())
+                {
+                    context->log("djv::app::ThumbnailCacheModel", value, feather_tk::LogType::Error);
+                }
+            }
+        };
+
+        void ThumbnailCacheModel::_init(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::filesystem::path& directory)
+        {
+            FEATHER_TK_P();
+
+            p.context = context;
+            p.directory = directory;
+
+            p.running = true;
+            p.thread = std::thread(
+                [this]
+                {
+                    _run();
+                });
+        }
+
+        ThumbnailCacheModel::ThumbnailCacheModel() :
+            _p(new Private)
+        {}
+
+        ThumbnailCacheModel::~ThumbnailCacheModel()
+        {
+            FEATHER_TK_P();
+            p.running = false;
+            p.cv.notify_one();
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+        }
+
+        std::shared_ptr<ThumbnailCacheModel> ThumbnailCacheModel::create(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::filesystem::path& directory)
+        {
+            auto out = std::shared_ptr<ThumbnailCacheModel>(new ThumbnailCacheModel);
+            out->_init(context, directory);
+            return out;
+        }
+
+        std::future<std::shared_ptr<feather_tk::Image> > ThumbnailCacheModel::get(
+            const tl::file::Path& path,
+            int height,
+            const OTIO_NS::RationalTime& time)
+        {
+            FEATHER_TK_P();
+            auto request = std::make_shared<Private::Request>();
+            request->path = path;
+            request->height = height;
+            request->time = time;
+            auto out = request->promise.get_future();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.requests.push_back(request);
+            }
+            p.cv.notify_one();
+            return out;
+        }
+
+        void ThumbnailCacheModel::add(
+            const tl::file::Path& path,
+            int height,
+            const std::shared_ptr<feather_tk::Image>& image,
+            const OTIO_NS::RationalTime& time)
+        {
+            FEATHER_TK_P();
+            if (image)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    if (p.mutex.writeQueue.size() < writeQueueMax)
+                    {
+                        p.mutex.writeQueue.push_back({ path, height, time, image });
+                    }
+                }
+                p.cv.notify_one();
+            }
+        }
+
+        void ThumbnailCacheModel::_run()
+        {
+            FEATHER_TK_P();
+
+            // Find the size of the store and remove any temporary files
+            // left over from a crash.
+            struct Entry
+            {
+                std::filesystem::path path;
+                std::filesystem::file_time_type time;
+                size_t size = 0;
+            };
+            std::vector<Entry> entries;
+            size_t size = 0;
+            try
+            {
+                std::filesystem::create_directories(p.directory);
+                for (const auto& i : std::filesystem::directory_iterator(p.directory))
+                {
+                    if (i.is_regular_file())
+                    {
+                        if (i.path().extension() == extension)
+                        {
+                            entries.push_back({ i.path(), i.last_write_time(), i.file_size() });
+                            size += entries.back().size;
+                        }
+                        else if (i.path().extension() == ".tmp")
+                        {
+                            std::filesystem::remove(i.path());
+                        }
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                p.log(e.what());
+            }
+
+            while (p.running)
+            {
+                // Remove the oldest thumbnails when the store is too large.
+                if (size > sizeMax)
+                {
+                    std::sort(
+                        entries.begin(),
+                        entries.end(),
+                        [](const Entry& a, const Entry& b)
+                        {
+                            return a.time > b.time;
+                        });
+                    while (size > sizeMax * 3 / 4 && !entries.empty())
+                    {
+                        std::error_code ec;
+                        std::filesystem::remove(entries.back().path, ec);
+                        size -= std::min(size, entries.back().size);
+                        entries.pop_back();
+                    }
+                }
+
+                std::list<std::shared_ptr<Private::Request> > requests;
+                std::list<Private::Write> writeQueue;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    if (p.cv.wait_for(
+                        lock,
+                        timeout,
+                        [this]
+                        {
+                            return
+                                !_p->mutex.requests.empty() ||
+                                !_p->mutex.writeQueue.empty() ||
+                                !_p->running;
+                        }))
+                    {
+                        std::swap(requests, p.mutex.requests);
+                        std::swap(writeQueue, p.mutex.writeQueue);
+                    }
+                }
+
+                // Read the requested thumbnails first so that they are
+                // shown as soon as possible.
+                for (const auto& request : requests)
+                {
+                    std::shared_ptr<feather_tk::Image> image;
+                    try
+                    {
+                        const std::string key = getKey(request->path, request->height, request->time);
+                        image = readFile(p.directory / getFileName(key), key);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        p.log(e.what());
+                    }
+                    request->promise.set_value(image);
+                }
+
+                for (const auto& write : writeQueue)
+                {
+                    try
+                    {
+                        const std::string key = getKey(write.path, write.height, write.time);
+                        const std::filesystem::path path = p.directory / getFileName(key);
+                        writeFile(path, key, write.image);
+                        const size_t fileSize = std::filesystem::file_size(path);
+
+                        // Replace the entry of a thumbnail that was written
+                        // again, so that it is not counted twice.
+                        const auto i = std::find_if(
+                            entries.begin(),
+                            entries.end(),
+                            [path](const Entry& value)
+                            {
+                                return value.path == path;
+                            });
+                        if (i != entries.end())
+                        {
+                            size -= std::min(size, i->size);
+                            entries.erase(i);
+                        }
+                        entries.push_back({ path, std::filesystem::last_write_time(path), fileSize });
+                        size += fileSize;
+                    }
+                    catch (const std::exception& e)
+                    {
+                        p.log(e.what());
+                    }
+                }
+            }
+
+            // Cancel the remaining requests.
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            for (const auto& request : p.mutex.requests)
+            {
+                request->promise.set_value(nullptr);
+            }
+        }
+    }
+}
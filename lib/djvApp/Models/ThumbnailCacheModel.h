@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Path.h>
+#include <tlCore/Time.h>
+
+#include <feather-tk/core/Image.h>
+
+#include <filesystem>
+#include <future>
+#include <memory>
+
+namespace feather_tk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        //! Thumbnail cache model.
+        //!
+        //! This is a persistent store of thumbnails, so that they are
+        //! available without decoding the files after a restart. The
+        //! thumbnails are keyed by the file path, modification time, time,
+        //! and height, so a thumbnail is invalidated when its file changes.
+        //! The oldest thumbnails are removed when the store is larger than
+        //! the maximum size.
+        //!
+        //! The thumbnails are read and written on a separate thread.
+        class ThumbnailCacheModel : public std::enable_shared_from_this<ThumbnailCacheModel>
+        {
+            FEATHER_TK_NON_COPYABLE(ThumbnailCacheModel);
+
+        protected:
+            void _init(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::filesystem::path& directory);
+
+            ThumbnailCacheModel();
+
+        public:
+            ~ThumbnailCacheModel();
+
+            //! Create a new model.
+            static std::shared_ptr<ThumbnailCacheModel> create(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::filesystem::path& directory);
+
+            //! Get a thumbnail from the cache. The future returns null if
+            //! the thumbnail is not in the cache.
+            std::future<std::shared_ptr<feather_tk::Image> > get(
+                const tl::file::Path&,
+                int height,
+                const OTIO_NS::RationalTime& = tl::time::invalidTime);
+
+            //! Add a thumbnail to the cache.
+            void add(
+                const tl::file::Path&,
+                int height,
+                const std::shared_ptr<feather_tk::Image>&,
+                const OTIO_NS::RationalTime& = tl::time::invalidTime);
+
+        private:
+            void _run();
+
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Models/ThumbnailScheduler.h>
+
+#include <djvApp/Models/ThumbnailCacheModel.h>
+
+#include <tlTimelineUI/ThumbnailSystem.h>
+
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/Timer.h>
+
+#include <chrono>
+#include <map>
+#include <tuple>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            const std::chrono::milliseconds timeout(50);
+
+            //! The maximum number of thumbnails decoded at the same time.
+            const size_t decodeMax = 4;
+
+            //! The maximum number of thumbnails decoded at the same time
+            //! during playback.
+            const size_t decodePlaybackMax = 1;
+
+            enum class State
+            {
+                Cache,
+                Pending,
+                Decode
+            };
+        }
+
+        bool ThumbnailPriority::operator < (const ThumbnailPriority& other) const
+        {
+            return
+                std::make_tuple(!visible, priority, order) <
+                std::make_tuple(!other.visible, other.priority, other.order);
+        }
+
+        struct ThumbnailScheduler::Private
+        {
+            std::weak_ptr<feather_tk::Context> context;
+            std::shared_ptr<ThumbnailCacheModel> thumbnailCache;
+            bool playback = false;
+
+            struct Item
+            {
+                tl::file::Path path;
+                int height = 0;
+                ThumbnailPriority priority;
+                State state = State::Cache;
+                std::future<std::shared_ptr<feather_tk::Image> > cached;
+                tl::timelineui::ThumbnailRequest request;
+                std::promise<std::shared_ptr<feather_tk::Image> > promise;
+            };
+            std::map<intptr_t, Item> items;
+            uint64_t order = 0;
+
+            std::shared_ptr<feather_tk::Timer> timer;
+            std::shared_ptr<feather_tk::ValueObserver<tl::timeline::Playback> > playbackObserver;
+        };
+
+        void ThumbnailScheduler::_init(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<ThumbnailCacheModel>& thumbnailCache)
+        {
+            FEATHER_TK_P();
+
+            p.context = context;
+            p.thumbnailCache = thumbnailCache;
+
+            p.timer = feather_tk::Timer::create(context);
+            p.timer->setRepeating(true);
+            p.timer->start(
+                timeout,
+                [this]
+                {
+                    _tick();
+                });
+        }
+
+        ThumbnailScheduler::ThumbnailScheduler() :
+            _p(new Private)
+        {}
+
+        ThumbnailScheduler::~ThumbnailScheduler()
+        {}
+
+        std::shared_ptr<ThumbnailScheduler> ThumbnailScheduler::create(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<ThumbnailCacheModel>& thumbnailCache)
+        {
+            auto out = std::shared_ptr<ThumbnailScheduler>(new ThumbnailScheduler);
+            out->_init(context, thumbnailCache);
+            return out;
+        }
+
+        void ThumbnailScheduler::setPlayer(const std::shared_ptr<tl::timeline::Player>& value)
+        {
+            FEATHER_TK_P();
+            p.playback = false;
+            p.playbackObserver.reset();
+            if (value)
+            {
+                p.playbackObserver = feather_tk::ValueObserver<tl::timeline::Playback>::create(
+                    value->observePlayback(),
+                    [this](tl::timeline::Playback value)
+                    {
+                        _p->playback = value != tl::timeline::Playback::Stop;
+                    });
+            }
+        }
+
+        std::future<std::shared_ptr<feather_tk::Image> > ThumbnailScheduler::request(
+            intptr_t id,
+            const tl::file::Path& path,
+            int height)
+        {
+            FEATHER_TK_P();
+            cancel(id);
+            Private::Item& item = p.items[id];
+            item.path = path;
+            item.height = height;
+            item.priority.order = p.order++;
+            item.cached = p.thumbnailCache->get(path, height);
+            return item.promise.get_future();
+        }
+
+        void ThumbnailScheduler::setPriority(intptr_t id, bool visible, int priority)
+        {
+            FEATHER_TK_P();
+            const auto i = p.items.find(id);
+            if (i != p.items.end())
+            {
+                i->second.priority.visible = visible;
+                i->second.priority.priority = priority;
+            }
+        }
+
+        void ThumbnailScheduler::cancel(intptr_t id)
+        {
+            FEATHER_TK_P();
+            const auto i = p.items.find(id);
+            if (i != p.items.end())
+            {
+                if (State::Decode == i->second.state)
+                {
+                    if (auto context = p.context.lock())
+                    {
+                        auto thumbnailSystem = context->getSystem<tl::timelineui::ThumbnailSystem>();
+                        thumbnailSystem->cancelRequests({ i->second.request.id });
+                    }
+                }
+                p.items.erase(i);
+            }
+        }
+
+        void ThumbnailScheduler::_tick()
+        {
+            FEATHER_TK_P();
+
+            // Check the cache lookups and the decodes.
+            size_t decodes = 0;
+            auto i = p.items.begin();
+            while (i != p.items.end())
+            {
+                Private::Item& item = i->second;
+                bool done = false;
+                switch (item.state)
+                {
+                case State::Cache:
+                    if (item.cached.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        if (auto image = item.cached.get())
+                        {
+                            item.promise.set_value(image);
+                            done = true;
+                        }
+                        else
+                        {
+                            item.state = State::Pending;
+                        }
+                    }
+                    break;
+                case State::Decode:
+                    if (item.request.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        const auto image = item.request.future.get();
+                        p.thumbnailCache->add(item.path, item.height, image);
+                        item.promise.set_value(image);
+                        done = true;
+                    }
+                    else
+                    {
+                        ++decodes;
+                    }
+                    break;
+                default: break;
+                }
+                if (done)
+                {
+                    i = p.items.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+
+            // Start the pending requests that are visible, then by
+            // priority, then in the order they were requested.
+            auto context = p.context.lock();
+            const size_t max = p.playback ? decodePlaybackMax : decodeMax;
+            bool pending = true;
+            while (context && pending && decodes < max)
+            {
+                auto next = p.items.end();
+                for (auto j = p.items.begin(); j != p.items.end(); ++j)
+                {
+                    if (State::Pending == j->second.state &&
+                        (next == p.items.end() || j->second.priority < next->second.priority))
+                    {
+                        next = j;
+                    }
+                }
+                if (next != p.items.end())
+                {
+                    auto thumbnailSystem = context->getSystem<tl::timelineui::ThumbnailSystem>();
+                    next->second.request = thumbnailSystem->getThumbnail(
+                        next->first,
+                        next->second.path,
+                        next->second.height);
+                    next->second.state = State::Decode;
+                    ++decodes;
+                }
+                else
+                {
+                    pending = false;
+                }
+            }
+        }
+    }
+}
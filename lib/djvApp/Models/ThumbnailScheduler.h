@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/Player.h>
+
+#include <feather-tk/core/Image.h>
+
+#include <future>
+
+namespace feather_tk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        class ThumbnailCacheModel;
+
+        //! Thumbnail request priority.
+        struct ThumbnailPriority
+        {
+            bool visible = true;
+            int priority = 0;
+            uint64_t order = 0;
+
+            //! Requests that are visible come first, then the requests
+            //! with the lowest priority value, then the oldest requests.
+            bool operator < (const ThumbnailPriority&) const;
+        };
+
+        //! Thumbnail scheduler.
+        //!
+        //! This schedules the thumbnail requests so that they do not
+        //! compete with playback. Requests that are visible are started
+        //! first, followed by the requests with the lowest priority value.
+        //! The number of thumbnails decoded at the same time is limited,
+        //! and only one thumbnail is decoded at a time during playback.
+        //!
+        //! Thumbnails are read from the thumbnail cache when they are
+        //! available, and new thumbnails are added to it.
+        class ThumbnailScheduler : public std::enable_shared_from_this<ThumbnailScheduler>
+        {
+            FEATHER_TK_NON_COPYABLE(ThumbnailScheduler);
+
+        protected:
+            void _init(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<ThumbnailCacheModel>&);
+
+            ThumbnailScheduler();
+
+        public:
+            ~ThumbnailScheduler();
+
+            //! Create a new scheduler.
+            static std::shared_ptr<ThumbnailScheduler> create(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<ThumbnailCacheModel>&);
+
+            //! Set the current player.
+            void setPlayer(const std::shared_ptr<tl::timeline::Player>&);
+
+            //! Request a thumbnail. The ID identifies the request for the
+            //! other functions, any previous request with the same ID is
+            //! canceled.
+            std::future<std::shared_ptr<feather_tk::Image> > request(
+                intptr_t id,
+                const tl::file::Path&,
+                int height);
+
+            //! Set whether a request is visible, and the priority of the
+            //! request. Lower values are started first.
+            void setPriority(intptr_t id, bool visible, int priority);
+
+            //! Cancel a request.
+            void cancel(intptr_t id);
+
+        private:
+            void _tick();
+
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
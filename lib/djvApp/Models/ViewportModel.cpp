@@ -6,10 +6,41 @@
 
 #include <feather-tk/ui/Settings.h>
 
+#include <array>
+
 namespace djv
 {
     namespace app
     {
+        FEATHER_TK_ENUM_IMPL(
+            ProxyResolution,
+            "Half",
+            "Quarter",
+            "Eighth");
+
+        bool ProxyOptions::operator == (const ProxyOptions& other) const
+        {
+            return
+                enabled == other.enabled &&
+                resolution == other.resolution;
+        }
+
+        bool ProxyOptions::operator != (const ProxyOptions& other) const
+        {
+            return !(*this == other);
+        }
+
+        int getProxyScale(const ProxyOptions& value)
+        {
+            const std::array<int, static_cast<size_t>(ProxyResolution::Count)> data =
+            {
+                2,
+                4,
+                8
+            };
+            return value.enabled ? data[static_cast<size_t>(value.resolution)] : 1;
+        }
+
         struct ViewportModel::Private
         {
             std::weak_ptr<feather_tk::Context> context;
@@ -20,7 +51,9 @@ namespace djv
             std::shared_ptr<feather_tk::ObservableValue<tl::timeline::BackgroundOptions> > backgroundOptions;
             std::shared_ptr<feather_tk::ObservableValue<tl::timeline::ForegroundOptions> > foregroundOptions;
             std::shared_ptr<feather_tk::ObservableValue<feather_tk::ImageType> > colorBuffer;
+            std::shared_ptr<feather_tk::ObservableValue<ProxyOptions> > proxyOptions;
             std::shared_ptr<feather_tk::ObservableValue<bool> > hud;
+            std::shared_ptr<feather_tk::ObservableValue<bool> > frameGraph;
         };
 
         void ViewportModel::_init(
@@ -58,9 +91,20 @@ namespace djv
             feather_tk::from_string(s, colorBuffer);
             p.colorBuffer = feather_tk::ObservableValue<feather_tk::ImageType>::create(colorBuffer);
 
+            ProxyOptions proxyOptions;
+            p.settings->get("/Viewport/Proxy/Enabled", proxyOptions.enabled);
+            s = feather_tk::to_string(proxyOptions.resolution);
+            p.settings->get("/Viewport/Proxy/Resolution", s);
+            feather_tk::from_string(s, proxyOptions.resolution);
+            p.proxyOptions = feather_tk::ObservableValue<ProxyOptions>::create(proxyOptions);
+
             bool hud = false;
             p.settings->get("/Viewport/HUD/Enabled", hud);
             p.hud = feather_tk::ObservableValue<bool>::create(hud);
+
+            bool frameGraph = false;
+            p.settings->get("/Viewport/HUD/FrameGraph", frameGraph);
+            p.frameGraph = feather_tk::ObservableValue<bool>::create(frameGraph);
         }
 
         ViewportModel::ViewportModel() :
@@ -75,7 +119,10 @@ namespace djv
             p.settings->setT("/Viewport/Background", p.backgroundOptions->get());
             p.settings->setT("/Viewport/Foreground", p.foregroundOptions->get());
             p.settings->set("/Viewport/ColorBuffer", feather_tk::to_string(p.colorBuffer->get()));
+            p.settings->set("/Viewport/Proxy/Enabled", p.proxyOptions->get().enabled);
+            p.settings->set("/Viewport/Proxy/Resolution", feather_tk::to_string(p.proxyOptions->get().resolution));
             p.settings->set("/Viewport/HUD/Enabled", p.hud->get());
+            p.settings->set("/Viewport/HUD/FrameGraph", p.frameGraph->get());
         }
 
         std::shared_ptr<ViewportModel> ViewportModel::create(
@@ -179,6 +226,21 @@ namespace djv
             _p->colorBuffer->setIfChanged(value);
         }
 
+        const ProxyOptions& ViewportModel::getProxyOptions() const
+        {
+            return _p->proxyOptions->get();
+        }
+
+        std::shared_ptr<feather_tk::IObservableValue<ProxyOptions> > ViewportModel::observeProxyOptions() const
+        {
+            return _p->proxyOptions;
+        }
+
+        void ViewportModel::setProxyOptions(const ProxyOptions& value)
+        {
+            _p->proxyOptions->setIfChanged(value);
+        }
+
         bool ViewportModel::getHUD() const
         {
             return _p->hud->get();
@@ -193,5 +255,20 @@ namespace djv
         {
             _p->hud->setIfChanged(value);
         }
+
+        bool ViewportModel::getFrameGraph() const
+        {
+            return _p->frameGraph->get();
+        }
+
+        std::shared_ptr<feather_tk::IObservableValue<bool> > ViewportModel::observeFrameGraph() const
+        {
+            return _p->frameGraph;
+        }
+
+        void ViewportModel::setFrameGraph(bool value)
+        {
+            _p->frameGraph->setIfChanged(value);
+        }
     }
 }
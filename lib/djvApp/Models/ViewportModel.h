@@ -20,6 +20,35 @@ namespace djv
 {
     namespace app
     {
+        //! USD proxy resolutions.
+        enum class ProxyResolution
+        {
+            Half,
+            Quarter,
+            Eighth,
+
+            Count,
+            First = Half
+        };
+        FEATHER_TK_ENUM(ProxyResolution);
+
+        //! USD proxy options.
+        //!
+        //! When the proxy is enabled, USD files are rendered at a reduced
+        //! resolution, so that they render faster and the frames use less
+        //! of the cache. The other file formats are not affected.
+        struct ProxyOptions
+        {
+            bool enabled = false;
+            ProxyResolution resolution = ProxyResolution::Half;
+
+            bool operator == (const ProxyOptions&) const;
+            bool operator != (const ProxyOptions&) const;
+        };
+
+        //! Get the USD proxy scale, one for full resolution.
+        int getProxyScale(const ProxyOptions&);
+
         //! Viewport model.
         class ViewportModel : public std::enable_shared_from_this<ViewportModel>
         {
@@ -94,6 +123,15 @@ namespace djv
             //! Set the color buffer type.
             void setColorBuffer(feather_tk::ImageType);
 
+            //! Get the proxy options.
+            const ProxyOptions& getProxyOptions() const;
+
+            //! Observe the proxy options.
+            std::shared_ptr<feather_tk::IObservableValue<ProxyOptions> > observeProxyOptions() const;
+
+            //! Set the proxy options.
+            void setProxyOptions(const ProxyOptions&);
+
             //! Get whether the HUD is enabled.
             bool getHUD() const;
 
@@ -103,6 +141,15 @@ namespace djv
             //! Set whether the HUD is enabled.
             void setHUD(bool);
 
+            //! Get whether the HUD frame timing graph is enabled.
+            bool getFrameGraph() const;
+
+            //! Observe whether the HUD frame timing graph is enabled.
+            std::shared_ptr<feather_tk::IObservableValue<bool> > observeFrameGraph() const;
+
+            //! Set whether the HUD frame timing graph is enabled.
+            void setFrameGraph(bool);
+
         private:
             FEATHER_TK_PRIVATE();
         };
@@ -0,0 +1,539 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Models/WaveformModel.h>
+
+#include <tlIO/System.h>
+
+#include <tlCore/Audio.h>
+
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/Format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        std::vector<WaveformPeak> Waveform::getPeaks(
+            const OTIO_NS::TimeRange& range,
+            int pixels) const
+        {
+            std::vector<WaveformPeak> out;
+            if (pixels > 0 && !levels.empty() && !levels.front().empty())
+            {
+                out.resize(pixels);
+                const double rate = timeRange.duration().rate();
+                const double start =
+                    range.start_time().rescaled_to(rate).value() -
+                    timeRange.start_time().value();
+                const double samplesPerPixel = range.duration().rescaled_to(rate).value() / pixels;
+
+                // Use the level with the largest peaks that are not larger
+                // than a pixel, so that each pixel covers at most a few peaks.
+                size_t level = 0;
+                while (level + 1 < levels.size() &&
+                    (waveformSamples << (level + 1)) <= samplesPerPixel)
+                {
+                    ++level;
+                }
+                const std::vector<WaveformPeak>& peaks = levels[level];
+                const double samplesPerPeak = static_cast<double>(waveformSamples << level);
+                const int64_t size = static_cast<int64_t>(peaks.size());
+                for (int i = 0; i < pixels; ++i)
+                {
+                    const int64_t p0 = static_cast<int64_t>(
+                        std::floor((start + i * samplesPerPixel) / samplesPerPeak));
+                    const int64_t p1 = std::max(
+                        p0 + 1,
+                        static_cast<int64_t>(std::floor((start + (i + 1) * samplesPerPixel) / samplesPerPeak)));
+                    WaveformPeak& peak = out[i];
+                    for (int64_t j = std::max(p0, int64_t(0)); j < std::min(p1, size); ++j)
+                    {
+                        peak.min = std::min(peak.min, peaks[j].min);
+                        peak.max = std::max(peak.max, peaks[j].max);
+                    }
+                }
+            }
+            return out;
+        }
+
+        std::vector<std::vector<WaveformPeak> > getWaveformLevels(std::vector<WaveformPeak> peaks)
+        {
+            std::vector<std::vector<WaveformPeak> > out;
+            out.push_back(std::move(peaks));
+            while (out.back().size() > 1)
+            {
+                const std::vector<WaveformPeak>& prev = out.back();
+                std::vector<WaveformPeak> level((prev.size() + 1) / 2);
+                for (size_t i = 0; i < level.size(); ++i)
+                {
+                    const WaveformPeak& a = prev[i * 2];
+                    const WaveformPeak& b = i * 2 + 1 < prev.size() ? prev[i * 2 + 1] : a;
+                    level[i].min = std::min(a.min, b.min);
+                    level[i].max = std::max(a.max, b.max);
+                }
+                out.push_back(std::move(level));
+            }
+            return out;
+        }
+
+        namespace
+        {
+            const std::chrono::milliseconds timeout(100);
+
+            //! The maximum number of waveforms cached in memory.
+            const size_t memoryCacheMax = 16;
+
+            //! The maximum size of the disk cache.
+            const size_t diskCacheMax = 64 * 1024 * 1024;
+
+            //! The number of seconds of audio read at a time.
+            const int64_t readSeconds = 10;
+
+            const std::string extension = ".djvwave";
+
+            struct FileHeader
+            {
+                char magic[4] = { 'D', 'J', 'V', 'W' };
+                uint32_t version = 1;
+                uint32_t keySize = 0;
+                double rate = 0.0;
+                double start = 0.0;
+                double duration = 0.0;
+                uint64_t peakCount = 0;
+            };
+
+            std::string getKey(const tl::file::Path& path)
+            {
+                const std::string fileName = path.get();
+                int64_t modified = 0;
+                std::error_code ec;
+                const auto lastWriteTime = std::filesystem::last_write_time(
+                    std::filesystem::u8path(fileName),
+                    ec);
+                if (!ec)
+                {
+                    modified = lastWriteTime.time_since_epoch().count();
+                }
+                std::stringstream ss;
+                ss << fileName << ";" << modified;
+                return ss.str();
+            }
+
+            std::string getFileName(const std::string& key)
+            {
+                // FNV-1a hash.
+                uint64_t hash = 14695981039346656037ULL;
+                for (const char c : key)
+                {
+                    hash ^= static_cast<uint8_t>(c);
+                    hash *= 1099511628211ULL;
+                }
+                std::stringstream ss;
+                ss << std::hex << std::setfill('0') << std::setw(16) << hash << extension;
+                return ss.str();
+            }
+
+            //! Get the minimum and maximum of the samples. This is kept as a
+            //! simple loop over contiguous data so that the compiler can
+            //! vectorize it.
+            void reduce(const float* data, size_t size, WaveformPeak& peak)
+            {
+                float min = peak.min;
+                float max = peak.max;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    min = data[i] < min ? data[i] : min;
+                    max = data[i] > max ? data[i] : max;
+                }
+                peak.min = min;
+                peak.max = max;
+            }
+
+            std::shared_ptr<Waveform> readAudio(
+                const std::shared_ptr<feather_tk::Context>& context,
+                const tl::file::Path& path,
+                const std::atomic<bool>& running)
+            {
+                std::shared_ptr<Waveform> out;
+                auto ioSystem = context->getSystem<tl::io::ReadSystem>();
+                if (auto read = ioSystem->read(path))
+                {
+                    const tl::io::Info info = read->getInfo().get();
+                    if (info.audio.isValid())
+                    {
+                        const double rate = info.audio.sampleRate;
+                        const OTIO_NS::TimeRange timeRange(
+                            info.audioTime.start_time().rescaled_to(rate).round(),
+                            info.audioTime.duration().rescaled_to(rate).round());
+                        const int64_t start = static_cast<int64_t>(timeRange.start_time().value());
+                        const int64_t duration = static_cast<int64_t>(timeRange.duration().value());
+                        const int64_t chunk = static_cast<int64_t>(rate) * readSeconds;
+                        std::vector<WaveformPeak> peaks;
+                        WaveformPeak peak;
+                        size_t peakSamples = 0;
+                        for (int64_t t = 0; t < duration && running; t += chunk)
+                        {
+                            const auto audioData = read->readAudio(OTIO_NS::TimeRange(
+                                OTIO_NS::RationalTime(start + t, rate),
+                                OTIO_NS::RationalTime(std::min(chunk, duration - t), rate))).get();
+                            if (audioData.audio)
+                            {
+                                const auto audio = tl::audio::convert(
+                                    audioData.audio,
+                                    tl::audio::DataType::F32);
+                                const size_t channelCount = audio->getChannelCount();
+                                const float* data = reinterpret_cast<const float*>(audio->getData());
+                                size_t sampleCount = audio->getSampleCount();
+                                while (sampleCount > 0)
+                                {
+                                    const size_t count = std::min(sampleCount, waveformSamples - peakSamples);
+                                    reduce(data, count * channelCount, peak);
+                                    data += count * channelCount;
+                                    sampleCount -= count;
+                                    peakSamples += count;
+                                    if (waveformSamples == peakSamples)
+                                    {
+                                        peaks.push_back(peak);
+                                        peak = WaveformPeak();
+                                        peakSamples = 0;
+                                    }
+                                }
+                            }
+                        }
+                        if (peakSamples > 0)
+                        {
+                            peaks.push_back(peak);
+                        }
+                        if (running)
+                        {
+                            out = std::make_shared<Waveform>();
+                            out->timeRange = timeRange;
+                            out->levels = getWaveformLevels(std::move(peaks));
+                        }
+                    }
+                }
+                return out;
+            }
+
+            void writeFile(
+                const std::filesystem::path& path,
+                const std::string& key,
+                const std::shared_ptr<Waveform>& waveform)
+            {
+                const std::vector<WaveformPeak>& peaks = waveform->levels.front();
+                FileHeader header;
+                header.keySize = static_cast<uint32_t>(key.size());
+                header.rate = waveform->timeRange.duration().rate();
+                header.start = waveform->timeRange.start_time().value();
+                header.duration = waveform->timeRange.duration().value();
+                header.peakCount = peaks.size();
+
+                // Write to a temporary file so that a partial file is never
+                // read.
+                std::filesystem::path tmp = path;
+                tmp += ".tmp";
+                {
+                    std::ofstream file(tmp, std::ios::binary);
+                    if (!file.is_open())
+                    {
+                        throw std::runtime_error(
+                            feather_tk::Format("Cannot open: \"{0}\"").arg(tmp.u8string()));
+                    }
+                    file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+                    file.write(key.data(), key.size());
+                    file.write(
+                        reinterpret_cast<const char*>(peaks.data()),
+                        peaks.size() * sizeof(WaveformPeak));
+                    if (!file)
+                    {
+                        throw std::runtime_error(
+                            feather_tk::Format("Cannot write: \"{0}\"").arg(tmp.u8string()));
+                    }
+                }
+                std::filesystem::rename(tmp, path);
+            }
+
+            std::shared_ptr<Waveform> readFile(
+                const std::filesystem::path& path,
+                const std::string& key)
+            {
+                std::shared_ptr<Waveform> out;
+                std::ifstream file(path, std::ios::binary);
+                FileHeader header;
+                std::string fileKey;
+                if (file.is_open() &&
+                    file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader)) &&
+                    0 == memcmp(header.magic, FileHeader().magic, 4) &&
+                    FileHeader().version == header.version &&
+                    header.keySize == key.size() &&
+                    header.peakCount > 0)
+                {
+                    fileKey.resize(header.keySize);
+                    if (file.read(fileKey.data(), header.keySize) && fileKey == key)
+                    {
+                        std::vector<WaveformPeak> peaks(header.peakCount);
+                        if (file.read(
+                            reinterpret_cast<char*>(peaks.data()),
+                            peaks.size() * sizeof(WaveformPeak)))
+                        {
+                            out = std::make_shared<Waveform>();
+                            out->timeRange = OTIO_NS::TimeRange(
+                                OTIO_NS::RationalTime(header.start, header.rate),
+                                OTIO_NS::RationalTime(header.duration, header.rate));
+                            out->levels = getWaveformLevels(std::move(peaks));
+                        }
+                    }
+                }
+                return out;
+            }
+
+            //! Remove the oldest waveforms when the disk cache is too large.
+            void pruneFiles(const std::filesystem::path& directory)
+            {
+                struct Entry
+                {
+                    std::filesystem::path path;
+                    std::filesystem::file_time_type time;
+                    size_t size = 0;
+                };
+                std::vector<Entry> entries;
+                size_t size = 0;
+                for (const auto& i : std::filesystem::directory_iterator(directory))
+                {
+                    if (i.is_regular_file() && i.path().extension() == extension)
+                    {
+                        entries.push_back({ i.path(), i.last_write_time(), i.file_size() });
+                        size += entries.back().size;
+                    }
+                }
+                std::sort(
+                    entries.begin(),
+                    entries.end(),
+                    [](const Entry& a, const Entry& b)
+                    {
+                        return a.time > b.time;
+                    });
+                while (size > diskCacheMax && !entries.empty())
+                {
+                    std::error_code ec;
+                    std::filesystem::remove(entries.back().path, ec);
+                    size -= std::min(size, entries.back().size);
+                    entries.pop_back();
+                }
+            }
+        }
+
+        struct WaveformModel::Private
+        {
+            std::weak_ptr<feather_tk::Context> context;
+            std::filesystem::path directory;
+
+            struct Request
+            {
+                tl::file::Path path;
+                std::promise<std::shared_ptr<Waveform> > promise;
+            };
+
+            struct Mutex
+            {
+                std::list<std::shared_ptr<Request> > requests;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+            std::condition_variable cv;
+            std::thread thread;
+            std::atomic<bool> running;
+
+            void log(const std::string& value)
+            {
+                if (auto context = this->context.lock())
+                {
+                    context->log("djv::app::WaveformModel", value, feather_tk::LogType::Error);
+                }
+            }
+        };
+
+        void WaveformModel::_init(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::filesystem::path& directory)
+        {
+            FEATHER_TK_P();
+
+            p.context = context;
+            p.directory = directory;
+
+            p.running = true;
+            p.thread = std::thread(
+                [this]
+                {
+                    _run();
+                });
+        }
+
+        WaveformModel::WaveformModel() :
+            _p(new Private)
+        {}
+
+        WaveformModel::~WaveformModel()
+        {
+            FEATHER_TK_P();
+            p.running = false;
+            p.cv.notify_one();
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+        }
+
+        std::shared_ptr<WaveformModel> WaveformModel::create(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::filesystem::path& directory)
+        {
+            auto out = std::shared_ptr<WaveformModel>(new WaveformModel);
+            out->_init(context, directory);
+            return out;
+        }
+
+        std::future<std::shared_ptr<Waveform> > WaveformModel::get(const tl::file::Path& path)
+        {
+            FEATHER_TK_P();
+            auto request = std::make_shared<Private::Request>();
+            request->path = path;
+            auto out = request->promise.get_future();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.requests.push_back(request);
+            }
+            p.cv.notify_one();
+            return out;
+        }
+
+        void WaveformModel::_run()
+        {
+            FEATHER_TK_P();
+
+            // Remove any temporary files left over from a crash, and the
+            // oldest waveforms when the disk cache is too large.
+            try
+            {
+                std::filesystem::create_directories(p.directory);
+                for (const auto& i : std::filesystem::directory_iterator(p.directory))
+                {
+                    if (i.is_regular_file() && i.path().extension() == ".tmp")
+                    {
+                        std::filesystem::remove(i.path());
+                    }
+                }
+                pruneFiles(p.directory);
+            }
+            catch (const std::exception& e)
+            {
+                p.log(e.what());
+            }
+
+            // The memory cache is only used by this thread.
+            std::list<std::pair<std::string, std::shared_ptr<Waveform> > > memoryCache;
+
+            while (p.running)
+            {
+                std::shared_ptr<Private::Request> request;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    if (p.cv.wait_for(
+                        lock,
+                        timeout,
+                        [this]
+                        {
+                            return !_p->mutex.requests.empty() || !_p->running;
+                        }) &&
+                        !p.mutex.requests.empty())
+                    {
+                        request = p.mutex.requests.front();
+                        p.mutex.requests.pop_front();
+                    }
+                }
+                if (request)
+                {
+                    std::shared_ptr<Waveform> waveform;
+                    try
+                    {
+                        const std::string key = getKey(request->path);
+                        const auto i = std::find_if(
+                            memoryCache.begin(),
+                            memoryCache.end(),
+                            [key](const std::pair<std::string, std::shared_ptr<Waveform> >& value)
+                            {
+                                return key == value.first;
+                            });
+                        bool cache = true;
+                        if (i != memoryCache.end())
+                        {
+                            waveform = i->second;
+                            memoryCache.erase(i);
+                        }
+                        else
+                        {
+                            const std::filesystem::path path = p.directory / getFileName(key);
+                            waveform = readFile(path, key);
+                            if (!waveform)
+                            {
+                                if (auto context = p.context.lock())
+                                {
+                                    waveform = readAudio(context, request->path, p.running);
+                                }
+                                if (waveform)
+                                {
+                                    writeFile(path, key, waveform);
+                                    pruneFiles(p.directory);
+                                }
+                                else
+                                {
+                                    // Files without audio are also cached, so
+                                    // that they are not read again. A null
+                                    // waveform is not cached if the read was
+                                    // cancelled.
+                                    cache = p.running;
+                                }
+                            }
+                        }
+                        if (cache)
+                        {
+                            memoryCache.push_front(std::make_pair(key, waveform));
+                            while (memoryCache.size() > memoryCacheMax)
+                            {
+                                memoryCache.pop_back();
+                            }
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        p.log(e.what());
+                    }
+                    request->promise.set_value(waveform);
+                }
+            }
+
+            // Cancel the remaining requests.
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            for (const auto& request : p.mutex.requests)
+            {
+                request->promise.set_value(nullptr);
+            }
+        }
+    }
+}
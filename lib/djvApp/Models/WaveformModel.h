@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Path.h>
+#include <tlCore/Time.h>
+
+#include <feather-tk/core/Util.h>
+
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace feather_tk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        //! Waveform peak.
+        struct WaveformPeak
+        {
+            float min = 0.F;
+            float max = 0.F;
+        };
+
+        //! The number of audio samples in each peak of the first waveform
+        //! level.
+        const size_t waveformSamples = 256;
+
+        //! Audio waveform.
+        //!
+        //! The waveform is stored as a pyramid of levels. The first level
+        //! has a peak for every "waveformSamples" samples, and each
+        //! following level has half as many peaks as the previous one.
+        struct Waveform
+        {
+            OTIO_NS::TimeRange timeRange = tl::time::invalidTimeRange;
+            std::vector<std::vector<WaveformPeak> > levels;
+
+            //! Get the peaks for the given number of pixels covering the
+            //! time range. The level with the closest resolution is used,
+            //! so the cost only depends on the number of pixels.
+            std::vector<WaveformPeak> getPeaks(
+                const OTIO_NS::TimeRange&,
+                int pixels) const;
+        };
+
+        //! Build the waveform levels from the peaks of the first level.
+        std::vector<std::vector<WaveformPeak> > getWaveformLevels(std::vector<WaveformPeak>);
+
+        //! Waveform model.
+        //!
+        //! This builds the waveforms on a separate thread the first time
+        //! they are requested. The waveforms are cached in memory and on
+        //! disk, keyed by the file path and modification time.
+        class WaveformModel : public std::enable_shared_from_this<WaveformModel>
+        {
+            FEATHER_TK_NON_COPYABLE(WaveformModel);
+
+        protected:
+            void _init(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::filesystem::path& directory);
+
+            WaveformModel();
+
+        public:
+            ~WaveformModel();
+
+            //! Create a new model.
+            static std::shared_ptr<WaveformModel> create(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::filesystem::path& directory);
+
+            //! Get a waveform. The future returns null if the file does
+            //! not have audio.
+            std::future<std::shared_ptr<Waveform> > get(const tl::file::Path&);
+
+        private:
+            void _run();
+
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
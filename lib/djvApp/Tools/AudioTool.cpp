@@ -5,6 +5,7 @@
 #include <djvApp/Tools/AudioTool.h>
 
 #include <djvApp/Models/AudioModel.h>
+#include <djvApp/Widgets/WaveformWidget.h>
 #include <djvApp/App.h>
 
 #include <feather-tk/ui/Bellows.h>
@@ -34,6 +35,7 @@ namespace djv
             std::vector<std::shared_ptr<feather_tk::CheckBox> > channelMuteCheckBoxes;
             std::shared_ptr<feather_tk::ButtonGroup> channelMuteButtonGroup;
             std::shared_ptr<feather_tk::DoubleEditSlider> syncOffsetSlider;
+            std::shared_ptr<WaveformWidget> waveformWidget;
 
             std::shared_ptr<feather_tk::HorizontalLayout> channelMuteLayout;
 
@@ -75,6 +77,8 @@ namespace djv
             p.syncOffsetSlider->setRange(-1.0, 1.0);
             p.syncOffsetSlider->setDefaultValue(0.0);
 
+            p.waveformWidget = WaveformWidget::create(context, app);
+
             auto formLayout = feather_tk::FormLayout::create(context);
             formLayout->setMarginRole(feather_tk::SizeRole::MarginSmall);
             formLayout->setSpacingRole(feather_tk::SizeRole::SpacingSmall);
@@ -85,6 +89,7 @@ namespace djv
             p.channelMuteLayout->setSpacingRole(feather_tk::SizeRole::SpacingTool);
             formLayout->addRow("Channel mute:", p.channelMuteLayout);
             formLayout->addRow("Sync offset:", p.syncOffsetSlider);
+            formLayout->addRow("Waveform:", p.waveformWidget);
 
             auto scrollWidget = feather_tk::ScrollWidget::create(context);
             scrollWidget->setBorder(false);
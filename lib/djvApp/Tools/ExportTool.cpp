@@ -4,15 +4,13 @@
 
 #include <djvApp/Tools/ExportTool.h>
 
+#include <djvApp/Export/ExportQueue.h>
 #include <djvApp/Models/ColorModel.h>
 #include <djvApp/Models/FilesModel.h>
 #include <djvApp/Models/SettingsModel.h>
 #include <djvApp/Models/ViewportModel.h>
 #include <djvApp/App.h>
 
-#include <tlTimelineGL/Render.h>
-
-#include <tlTimeline/IRender.h>
 #include <tlTimeline/Util.h>
 
 #include <tlIO/System.h>
@@ -20,26 +18,63 @@
 #include <tlIO/FFmpeg.h>
 #endif // TLRENDER_FFMPEG
 
+#include <feather-tk/ui/Bellows.h>
 #include <feather-tk/ui/ComboBox.h>
 #include <feather-tk/ui/DialogSystem.h>
 #include <feather-tk/ui/FileEdit.h>
 #include <feather-tk/ui/FormLayout.h>
+#include <feather-tk/ui/GridLayout.h>
 #include <feather-tk/ui/IntEdit.h>
+#include <feather-tk/ui/Label.h>
 #include <feather-tk/ui/LineEdit.h>
 #include <feather-tk/ui/ProgressDialog.h>
 #include <feather-tk/ui/PushButton.h>
 #include <feather-tk/ui/RowLayout.h>
 #include <feather-tk/ui/ScrollWidget.h>
-#include <feather-tk/gl/GL.h>
-#include <feather-tk/gl/OffscreenBuffer.h>
-#include <feather-tk/gl/Util.h>
+#include <feather-tk/ui/ToolButton.h>
 #include <feather-tk/core/Format.h>
 #include <feather-tk/core/Timer.h>
 
+#include <list>
+
 namespace djv
 {
     namespace app
     {
+        namespace
+        {
+            std::string getBaseName(const tl::file::Path& path, const std::string& baseName)
+            {
+                std::string out = path.getBaseName();
+                while (!out.empty() &&
+                    ('.' == out.back() || '_' == out.back() || '-' == out.back()))
+                {
+                    out.pop_back();
+                }
+                return out + "_" + baseName;
+            }
+
+            std::string getText(const ExportQueueItem& item)
+            {
+                std::string out;
+                switch (item.status)
+                {
+                case ExportStatus::Running:
+                    out = feather_tk::Format("{0} / {1}").
+                        arg(item.frameCount).
+                        arg(item.frameTotal);
+                    break;
+                case ExportStatus::Error:
+                    out = feather_tk::Format("Error: {0}").arg(item.error);
+                    break;
+                default:
+                    out = getLabel(item.status);
+                    break;
+                }
+                return out;
+            }
+        }
+
         struct ExportTool::Private
         {
             std::weak_ptr<App> app;
@@ -49,24 +84,10 @@ namespace djv
             std::vector<std::string> movieExtensions;
             std::vector<std::string> movieCodecs;
 
-            struct ExportData
-            {
-                OTIO_NS::TimeRange range;
-                int64_t frame = 0;
-                tl::file::Path path;
-                feather_tk::ImageInfo info;
-                std::shared_ptr<tl::io::IWrite> writer;
-                tl::timeline::OCIOOptions ocioOptions;
-                tl::timeline::LUTOptions lutOptions;
-                feather_tk::ImageOptions imageOptions;
-                tl::timeline::DisplayOptions displayOptions;
-                feather_tk::ImageType colorBuffer = feather_tk::ImageType::RGBA_U8;
-                std::shared_ptr<feather_tk::gl::OffscreenBuffer> buffer;
-                std::shared_ptr<tl::timeline::IRender> render;
-                GLenum glFormat = 0;
-                GLenum glType = 0;
-            };
-            std::unique_ptr<ExportData> exportData;
+            ExportOptions exportOptions;
+            std::future<std::shared_ptr<tl::timeline::Timeline> > exportTimeline;
+            std::list<std::future<std::shared_ptr<tl::timeline::Timeline> > > canceled;
+            std::shared_ptr<ExportJob> job;
 
             std::shared_ptr<feather_tk::FileEdit> directoryEdit;
             std::shared_ptr<feather_tk::ComboBox> renderSizeComboBox;
@@ -80,13 +101,25 @@ namespace djv
             std::shared_ptr<feather_tk::ComboBox> movieExtensionComboBox;
             std::shared_ptr<feather_tk::ComboBox> movieCodecComboBox;
             std::shared_ptr<feather_tk::PushButton> exportButton;
+            std::shared_ptr<feather_tk::PushButton> queueButton;
+            std::shared_ptr<feather_tk::PushButton> queueAllButton;
+            std::shared_ptr<feather_tk::IntEdit> jobsEdit;
+            std::vector<std::shared_ptr<feather_tk::Label> > queueStatusLabels;
+            std::vector<std::shared_ptr<feather_tk::ToolButton> > queueCancelButtons;
+            std::shared_ptr<feather_tk::ToolButton> cancelAllButton;
+            std::shared_ptr<feather_tk::ToolButton> clearButton;
             std::shared_ptr<feather_tk::HorizontalLayout> customSizeLayout;
             std::shared_ptr<feather_tk::FormLayout> formLayout;
             std::shared_ptr<feather_tk::VerticalLayout> layout;
+            std::shared_ptr<feather_tk::GridLayout> queueLayout;
+            std::map<std::string, std::shared_ptr<feather_tk::Bellows> > bellows;
             std::shared_ptr<feather_tk::ProgressDialog> progressDialog;
 
             std::shared_ptr<feather_tk::ValueObserver<std::shared_ptr<tl::timeline::Player> > > playerObserver;
             std::shared_ptr<feather_tk::ValueObserver<ExportSettings> > settingsObserver;
+            std::shared_ptr<feather_tk::ListObserver<std::shared_ptr<FilesModelItem> > > filesObserver;
+            std::shared_ptr<feather_tk::ListObserver<ExportQueueItem> > queueObserver;
+            std::shared_ptr<feather_tk::ValueObserver<int> > jobsObserver;
 
             std::shared_ptr<feather_tk::Timer> progressTimer;
         };
@@ -136,6 +169,17 @@ namespace djv
             p.movieCodecComboBox = feather_tk::ComboBox::create(context, p.movieCodecs);
 
             p.exportButton = feather_tk::PushButton::create(context, "Export");
+            p.queueButton = feather_tk::PushButton::create(context, "Add to Queue");
+            p.queueButton->setTooltip("Add the current file to the export queue");
+            p.queueAllButton = feather_tk::PushButton::create(context, "Add All to Queue");
+            p.queueAllButton->setTooltip("Add all of the open files to the export queue");
+
+            p.jobsEdit = feather_tk::IntEdit::create(context);
+            p.jobsEdit->setRange(1, 16);
+            p.jobsEdit->setTooltip("Maximum number of exports that are run at the same time");
+            p.cancelAllButton = feather_tk::ToolButton::create(context, "Cancel All");
+            p.clearButton = feather_tk::ToolButton::create(context, "Clear");
+            p.clearButton->setTooltip("Remove the finished exports from the queue");
 
             p.layout = feather_tk::VerticalLayout::create(context);
             p.layout->setMarginRole(feather_tk::SizeRole::MarginSmall);
@@ -156,13 +200,38 @@ namespace djv
             p.formLayout->addRow("Base name:", p.movieBaseNameEdit);
             p.formLayout->addRow("Extension:", p.movieExtensionComboBox);
             p.formLayout->addRow("Codec:", p.movieCodecComboBox);
-            p.exportButton->setParent(p.layout);
+            auto hLayout = feather_tk::HorizontalLayout::create(context, p.layout);
+            hLayout->setSpacingRole(feather_tk::SizeRole::SpacingSmall);
+            p.exportButton->setParent(hLayout);
+            p.queueButton->setParent(hLayout);
+            p.queueAllButton->setParent(hLayout);
+
+            auto vLayout = feather_tk::VerticalLayout::create(context);
+            vLayout->setMarginRole(feather_tk::SizeRole::MarginSmall);
+            vLayout->setSpacingRole(feather_tk::SizeRole::SpacingSmall);
+            auto formLayout = feather_tk::FormLayout::create(context, vLayout);
+            formLayout->setSpacingRole(feather_tk::SizeRole::SpacingSmall);
+            formLayout->addRow("Jobs:", p.jobsEdit);
+            p.queueLayout = feather_tk::GridLayout::create(context, vLayout);
+            p.queueLayout->setSpacingRole(feather_tk::SizeRole::SpacingSmall);
+            hLayout = feather_tk::HorizontalLayout::create(context, vLayout);
+            hLayout->setSpacingRole(feather_tk::SizeRole::SpacingTool);
+            p.cancelAllButton->setParent(hLayout);
+            p.clearButton->setParent(hLayout);
+
+            auto layout = feather_tk::VerticalLayout::create(context);
+            layout->setSpacingRole(feather_tk::SizeRole::None);
+            p.layout->setParent(layout);
+            p.bellows["Queue"] = feather_tk::Bellows::create(context, "Queue", layout);
+            p.bellows["Queue"]->setWidget(vLayout);
 
             auto scrollWidget = feather_tk::ScrollWidget::create(context);
             scrollWidget->setBorder(false);
-            scrollWidget->setWidget(p.layout);
+            scrollWidget->setWidget(layout);
             _setWidget(scrollWidget);
 
+            _loadSettings(p.bellows);
+
             p.playerObserver = feather_tk::ValueObserver<std::shared_ptr<tl::timeline::Player> >::create(
                 app->observePlayer(),
                 [this](const std::shared_ptr<tl::timeline::Player>& value)
@@ -170,6 +239,28 @@ namespace djv
                     FEATHER_TK_P();
                     p.player = value;
                     p.exportButton->setEnabled(value.get());
+                    p.queueButton->setEnabled(value.get());
+                });
+
+            p.filesObserver = feather_tk::ListObserver<std::shared_ptr<FilesModelItem> >::create(
+                app->getFilesModel()->observeFiles(),
+                [this](const std::vector<std::shared_ptr<FilesModelItem> >& value)
+                {
+                    _p->queueAllButton->setEnabled(!value.empty());
+                });
+
+            p.queueObserver = feather_tk::ListObserver<ExportQueueItem>::create(
+                app->getExportQueue()->observeItems(),
+                [this](const std::vector<ExportQueueItem>& value)
+                {
+                    _queueUpdate(value);
+                });
+
+            p.jobsObserver = feather_tk::ValueObserver<int>::create(
+                app->getExportQueue()->observeJobs(),
+                [this](int value)
+                {
+                    _p->jobsEdit->setValue(value);
                 });
 
             p.settingsObserver = feather_tk::ValueObserver<ExportSettings>::create(
@@ -293,6 +384,46 @@ namespace djv
                     _export();
                 });
 
+            p.queueButton->setClickedCallback(
+                [this]
+                {
+                    _addToQueue(false);
+                });
+
+            p.queueAllButton->setClickedCallback(
+                [this]
+                {
+                    _addToQueue(true);
+                });
+
+            auto appWeak = std::weak_ptr<App>(app);
+            p.jobsEdit->setCallback(
+                [appWeak](int value)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        app->getExportQueue()->setJobs(value);
+                    }
+                });
+
+            p.cancelAllButton->setClickedCallback(
+                [appWeak]
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        app->getExportQueue()->cancelAll();
+                    }
+                });
+
+            p.clearButton->setClickedCallback(
+                [appWeak]
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        app->getExportQueue()->clear();
+                    }
+                });
+
             p.progressTimer = feather_tk::Timer::create(context);
             p.progressTimer->setRepeating(true);
         }
@@ -302,7 +433,9 @@ namespace djv
         {}
 
         ExportTool::~ExportTool()
-        {}
+        {
+            _saveSettings(_p->bellows);
+        }
 
         std::shared_ptr<ExportTool> ExportTool::create(
             const std::shared_ptr<feather_tk::Context>& context,
@@ -356,131 +489,57 @@ namespace djv
             FEATHER_TK_P();
             auto context = getContext();
             auto app = p.app.lock();
-            if (app && context && p.player)
+            if (app && context && p.player && !p.progressDialog)
             {
-                try
-                {
-                    const tl::io::Info ioInfo = p.player->getIOInfo();
-                    if (ioInfo.video.empty())
-                    {
-                        throw std::runtime_error("No video to render");
-                    }
-                    p.exportData.reset(new Private::ExportData);
-
-                    // Get the time range.
-                    const auto options = p.model->getExport();
-                    switch (options.fileType)
-                    {
-                    case ExportFileType::Image:
-                        p.exportData->range = OTIO_NS::TimeRange(
-                            p.player->getCurrentTime(),
-                            OTIO_NS::RationalTime(1.0, p.player->getTimeRange().duration().rate()));
-                        break;
-                    default:
-                        p.exportData->range = p.player->getInOutRange();
-                        break;
-                    }
-                    p.exportData->frame = p.exportData->range.start_time().value();
-
-                    // Get the render size.
-                    switch (options.renderSize)
-                    {
-                    case ExportRenderSize::Default:
-                        p.exportData->info.size = ioInfo.video.front().size;
-                        break;
-                    case ExportRenderSize::Custom:
-                        p.exportData->info.size = options.customSize;
-                        break;
-                    default:
-                        p.exportData->info.size = getSize(options.renderSize);
-                        break;
-                    }
-
-                    // Get the export path.
-                    std::string fileName;
-                    switch (options.fileType)
-                    {
-                    case ExportFileType::Image:
-                    case ExportFileType::Sequence:
+                // Release the canceled timelines once they have finished loading.
+                p.canceled.remove_if(
+                    [](const std::future<std::shared_ptr<tl::timeline::Timeline> >& value)
                     {
-                        std::stringstream ss;
-                        ss << options.imageBaseName;
-                        ss << std::setfill('0') << std::setw(options.imageZeroPad) << p.exportData->range.start_time().value();
-                        ss << options.imageExtension;
-                        fileName = ss.str();
-                        break;
-                    }
-                    case ExportFileType::Movie:
-                    {
-                        std::stringstream ss;
-                        ss << options.movieBaseName << options.movieExtension;
-                        fileName = ss.str();
-                        break;
-                    }
-                    default: break;
-                    }
-                    p.exportData->path = tl::file::Path((std::filesystem::u8path(options.directory) /
-                        std::filesystem::u8path(fileName)).u8string());
+                        return value.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                    });
 
-                    // Get the writer.
-                    auto ioSystem = context->getSystem<tl::io::WriteSystem>();
-                    auto plugin = ioSystem->getPlugin(p.exportData->path);
-                    if (!plugin)
-                    {
-                        throw std::runtime_error(
-                            feather_tk::Format("Cannot open: \"{0}\"").arg(p.exportData->path.get()));
-                    }
-                    p.exportData->info.type = ioInfo.video.front().type;
-                    p.exportData->info = plugin->getInfo(p.exportData->info);
-                    if (feather_tk::ImageType::None == p.exportData->info.type)
+                try
+                {
+                    // Open the timeline again on a thread if the viewer
+                    // options, like the USD proxy, differ from the export
+                    // options.
+                    p.exportOptions = _getOptions();
+                    auto timeline = p.player->getTimeline();
+                    const tl::timeline::Options timelineOptions = app->getTimelineOptions();
+                    if (timeline->getOptions().ioOptions != timelineOptions.ioOptions)
                     {
-                        p.exportData->info.type = feather_tk::ImageType::RGBA_U8;
+                        p.exportTimeline = openExportTimeline(
+                            context,
+                            timeline->getPath(),
+                            timeline->getAudioPath(),
+                            timelineOptions);
                     }
-                    p.exportData->glFormat = feather_tk::gl::getReadPixelsFormat(p.exportData->info.type);
-                    p.exportData->glType = feather_tk::gl::getReadPixelsType(p.exportData->info.type);
-                    if (GL_NONE == p.exportData->glFormat || GL_NONE == p.exportData->glType)
+                    else
                     {
-                        throw std::runtime_error(
-                            feather_tk::Format("Cannot open: \"{0}\"").arg(p.exportData->path.get()));
+                        p.job = ExportJob::create(
+                            context,
+                            timeline,
+                            p.exportOptions,
+                            app->getFrameCacheModel());
                     }
-                    const double speed = p.player->getSpeed();
-                    tl::io::Info outputInfo;
-                    outputInfo.video.push_back(p.exportData->info);
-                    outputInfo.videoTime = OTIO_NS::TimeRange(
-                        OTIO_NS::RationalTime(0.0, speed),
-                        p.exportData->range.duration().rescaled_to(speed));
-                    tl::io::Options ioOptions;
-                    ioOptions["FFmpeg/Codec"] = options.movieCodec;
-                    p.exportData->writer = plugin->write(p.exportData->path, outputInfo, ioOptions);
-
-                    // Create the renderer.
-                    p.exportData->ocioOptions = app->getColorModel()->getOCIOOptions();
-                    p.exportData->lutOptions = app->getColorModel()->getLUTOptions();
-                    p.exportData->imageOptions = app->getViewportModel()->getImageOptions();
-                    p.exportData->displayOptions = app->getViewportModel()->getDisplayOptions();
-                    p.exportData->colorBuffer = app->getViewportModel()->getColorBuffer();
-                    p.exportData->render = tl::timeline_gl::Render::create(context);
-                    feather_tk::gl::OffscreenBufferOptions offscreenBufferOptions;
-                    offscreenBufferOptions.color = p.exportData->colorBuffer;
-                    p.exportData->buffer = feather_tk::gl::OffscreenBuffer::create(
-                        p.exportData->info.size,
-                        offscreenBufferOptions);
 
                     // Create the progress dialog.
                     p.progressDialog = feather_tk::ProgressDialog::create(
                         context,
                         "Export",
                         "Rendering:");
-                    p.progressDialog->setRange(0.0, p.exportData->range.duration().value() - 1.0);
-                    p.progressDialog->setMessage(feather_tk::Format("Frame: {0} / {1}").
-                        arg(p.exportData->frame).
-                        arg(p.exportData->range.end_time_inclusive().value()));
+                    _exportProgress();
                     p.progressDialog->setCloseCallback(
                         [this]
                         {
                             FEATHER_TK_P();
                             p.progressTimer->stop();
-                            p.exportData.reset();
+                            if (p.exportTimeline.valid())
+                            {
+                                // Don't wait for the timeline to finish loading.
+                                p.canceled.push_back(std::move(p.exportTimeline));
+                            }
+                            p.job.reset();
                             p.progressDialog.reset();
                         });
                     p.progressDialog->open(getWindow());
@@ -488,27 +547,12 @@ namespace djv
                         std::chrono::microseconds(500),
                         [this]
                         {
-                            FEATHER_TK_P();
-                            if (_exportFrame())
-                            {
-                                const int64_t start = p.exportData->range.start_time().value();
-                                p.progressDialog->setValue(p.exportData->frame - start);
-                                const int64_t end = p.exportData->range.end_time_inclusive().value();
-                                if (p.exportData->frame <= end)
-                                {
-                                    p.progressDialog->setMessage(feather_tk::Format("Frame: {0} / {1}").
-                                        arg(p.exportData->frame - start).
-                                        arg(static_cast<int64_t>(p.exportData->range.duration().value())));
-                                }
-                                else
-                                {
-                                    p.progressDialog->close();
-                                }
-                            }
+                            _exportTick();
                         });
                 }
                 catch (const std::exception& e)
                 {
+                    p.job.reset();
                     if (p.progressDialog)
                     {
                         p.progressDialog->close();
@@ -521,55 +565,37 @@ namespace djv
             }
         }
 
-        bool ExportTool::_exportFrame()
+        void ExportTool::_exportTick()
         {
             FEATHER_TK_P();
-            bool out = false;
             try
             {
-                // Get the video.
-                const OTIO_NS::RationalTime t(p.exportData->frame, p.exportData->range.duration().rate());
-                auto ioOptions = p.player->getTimeline()->getOptions().ioOptions;
-                ioOptions["Layer"] = feather_tk::Format("{0}").arg(p.player->getVideoLayer());
-                auto video = p.player->getTimeline()->getVideo(t, ioOptions).future.get();
-
-                // Render the video.
-                feather_tk::gl::OffscreenBufferBinding binding(p.exportData->buffer);
-                p.exportData->render->begin(p.exportData->info.size);
-                p.exportData->render->setOCIOOptions(p.exportData->ocioOptions);
-                p.exportData->render->setLUTOptions(p.exportData->lutOptions);
-                p.exportData->render->drawVideo(
-                    { video },
-                    { feather_tk::Box2I(0, 0, p.exportData->info.size.w, p.exportData->info.size.h) },
-                    { p.exportData->imageOptions },
-                    { p.exportData->displayOptions },
-                    tl::timeline::CompareOptions(),
-                    p.exportData->colorBuffer);
-                p.exportData->render->end();
-
-                // Write the output image.
-                auto image = feather_tk::Image::create(p.exportData->info);
-                glPixelStorei(GL_PACK_ALIGNMENT, p.exportData->info.layout.alignment);
-#if defined(dtk_API_GL_4_1)
-                glPixelStorei(GL_PACK_SWAP_BYTES, p.exportData->info.layout.endian != feather_tk::getEndian());
-#endif // dtk_API_GL_4_1
-                glReadPixels(
-                    0,
-                    0,
-                    p.exportData->info.size.w,
-                    p.exportData->info.size.h,
-                    p.exportData->glFormat,
-                    p.exportData->glType,
-                    image->getData());
-
-                const int64_t start = p.exportData->range.start_time().value();
-                const double speed = p.player->getSpeed();
-                const OTIO_NS::RationalTime t2(p.exportData->frame - start, speed);
-                p.exportData->writer->writeVideo(t2, image);
-
-                ++p.exportData->frame;
-
-                out = true;
+                // Create the export job when the timeline has finished
+                // loading.
+                if (p.exportTimeline.valid() &&
+                    p.exportTimeline.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    auto timeline = p.exportTimeline.get();
+                    auto context = getContext();
+                    auto app = p.app.lock();
+                    if (context && app)
+                    {
+                        p.job = ExportJob::create(
+                            context,
+                            timeline,
+                            p.exportOptions,
+                            app->getFrameCacheModel());
+                    }
+                }
+                if (p.job)
+                {
+                    const bool running = p.job->tick();
+                    _exportProgress();
+                    if (!running)
+                    {
+                        p.progressDialog->close();
+                    }
+                }
             }
             catch (const std::exception& e)
             {
@@ -585,7 +611,173 @@ namespace djv
                         getWindow());
                 }
             }
+        }
+
+        void ExportTool::_exportProgress()
+        {
+            FEATHER_TK_P();
+            if (p.job)
+            {
+                const int64_t count = p.job->getFrameCount();
+                const int64_t total = p.job->getFrameTotal();
+                p.progressDialog->setRange(0.0, total);
+                p.progressDialog->setValue(count);
+                p.progressDialog->setMessage(feather_tk::Format("Frame: {0} / {1}").
+                    arg(count).
+                    arg(total));
+            }
+            else
+            {
+                p.progressDialog->setMessage("Opening...");
+            }
+        }
+
+        ExportOptions ExportTool::_getOptions() const
+        {
+            FEATHER_TK_P();
+            ExportOptions out;
+            out.settings = p.model->getExport();
+            if (auto app = p.app.lock())
+            {
+                out.ocioOptions = app->getColorModel()->getOCIOOptions();
+                out.lutOptions = app->getColorModel()->getLUTOptions();
+                out.imageOptions = app->getViewportModel()->getImageOptions();
+                out.displayOptions = app->getViewportModel()->getDisplayOptions();
+                out.colorBuffer = app->getViewportModel()->getColorBuffer();
+            }
+            out.prefetch = p.model->getAdvanced().videoRequestMax;
+            if (p.player)
+            {
+                switch (out.settings.fileType)
+                {
+                case ExportFileType::Image:
+                    out.range = OTIO_NS::TimeRange(
+                        p.player->getCurrentTime(),
+                        OTIO_NS::RationalTime(1.0, p.player->getTimeRange().duration().rate()));
+                    break;
+                default:
+                    out.range = p.player->getInOutRange();
+                    break;
+                }
+                out.speed = p.player->getSpeed();
+                out.videoLayer = p.player->getVideoLayer();
+            }
             return out;
         }
+
+        void ExportTool::_addToQueue(bool all)
+        {
+            FEATHER_TK_P();
+            if (auto app = p.app.lock())
+            {
+                const auto& filesModel = app->getFilesModel();
+                const auto& a = filesModel->getA();
+                std::vector<std::shared_ptr<FilesModelItem> > items;
+                if (all)
+                {
+                    items = filesModel->getFiles();
+                }
+                else if (a)
+                {
+                    items.push_back(a);
+                }
+                const tl::timeline::Options timelineOptions = app->getTimelineOptions();
+                for (const auto& item : items)
+                {
+                    ExportQueueItem queueItem;
+                    queueItem.path = item->path;
+                    queueItem.audioPath = item->audioPath;
+                    queueItem.options = _getOptions();
+                    if (item != a || !p.player)
+                    {
+                        // Use the state stored in the files model for the
+                        // files that are not active.
+                        queueItem.options.range = tl::time::invalidTimeRange;
+                        if (ExportFileType::Image == queueItem.options.settings.fileType &&
+                            !tl::time::compareExact(item->currentTime, tl::time::invalidTime))
+                        {
+                            queueItem.options.range = OTIO_NS::TimeRange(
+                                item->currentTime,
+                                OTIO_NS::RationalTime(1.0, item->currentTime.rate()));
+                        }
+                        else if (ExportFileType::Image != queueItem.options.settings.fileType)
+                        {
+                            queueItem.options.range = item->inOutRange;
+                        }
+                        queueItem.options.speed = item->speed > 0.0 ? item->speed : 0.0;
+                        queueItem.options.videoLayer = item->videoLayer;
+                    }
+                    if (all && items.size() > 1)
+                    {
+                        // Use the file names to keep the outputs unique.
+                        auto& settings = queueItem.options.settings;
+                        settings.imageBaseName = getBaseName(item->path, settings.imageBaseName);
+                        settings.movieBaseName = getBaseName(item->path, settings.movieBaseName);
+                    }
+                    app->getExportQueue()->add(queueItem, timelineOptions);
+                }
+            }
+        }
+
+        void ExportTool::_queueUpdate(const std::vector<ExportQueueItem>& value)
+        {
+            FEATHER_TK_P();
+            auto appWeak = _app;
+            if (value.size() != p.queueStatusLabels.size())
+            {
+                p.queueStatusLabels.clear();
+                p.queueCancelButtons.clear();
+                auto children = p.queueLayout->getChildren();
+                for (const auto& widget : children)
+                {
+                    widget->setParent(nullptr);
+                }
+                children.clear();
+                if (auto context = getContext())
+                {
+                    for (size_t i = 0; i < value.size(); ++i)
+                    {
+                        auto label = feather_tk::Label::create(
+                            context,
+                            value[i].path.get(-1, tl::file::PathType::FileName),
+                            p.queueLayout);
+                        label->setTooltip(value[i].path.get());
+                        label->setHStretch(feather_tk::Stretch::Expanding);
+                        p.queueLayout->setGridPos(label, i, 0);
+
+                        auto statusLabel = feather_tk::Label::create(context, p.queueLayout);
+                        p.queueStatusLabels.push_back(statusLabel);
+                        p.queueLayout->setGridPos(statusLabel, i, 1);
+
+                        auto cancelButton = feather_tk::ToolButton::create(context, p.queueLayout);
+                        cancelButton->setIcon("Close");
+                        cancelButton->setTooltip("Cancel the export");
+                        p.queueCancelButtons.push_back(cancelButton);
+                        p.queueLayout->setGridPos(cancelButton, i, 2);
+                        cancelButton->setClickedCallback(
+                            [appWeak, i]
+                            {
+                                if (auto app = appWeak.lock())
+                                {
+                                    app->getExportQueue()->cancel(i);
+                                }
+                            });
+                    }
+                    if (value.empty())
+                    {
+                        auto label = feather_tk::Label::create(context, "No exports queued", p.queueLayout);
+                        p.queueLayout->setGridPos(label, 0, 0);
+                    }
+                }
+            }
+            for (size_t i = 0; i < value.size() && i < p.queueStatusLabels.size(); ++i)
+            {
+                p.queueStatusLabels[i]->setText(getText(value[i]));
+                p.queueStatusLabels[i]->setTooltip(value[i].output);
+                p.queueCancelButtons[i]->setEnabled(
+                    ExportStatus::Pending == value[i].status ||
+                    ExportStatus::Running == value[i].status);
+            }
+        }
     }
 }
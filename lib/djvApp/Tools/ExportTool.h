@@ -10,6 +10,8 @@ namespace djv
 {
     namespace app
     {
+        struct ExportOptions;
+        struct ExportQueueItem;
         struct ExportSettings;
 
         class App;
@@ -38,7 +40,11 @@ namespace djv
         private:
             void _widgetUpdate(const ExportSettings&);
             void _export();
-            bool _exportFrame();
+            void _exportTick();
+            void _exportProgress();
+            ExportOptions _getOptions() const;
+            void _addToQueue(bool all);
+            void _queueUpdate(const std::vector<ExportQueueItem>&);
 
             FEATHER_TK_PRIVATE();
         };
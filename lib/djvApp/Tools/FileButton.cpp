@@ -4,10 +4,11 @@
 
 #include <djvApp/Tools/FilesToolPrivate.h>
 
-#include <tlTimelineUI/ThumbnailSystem.h>
+#include <djvApp/Models/ThumbnailScheduler.h>
 
 #include <feather-tk/ui/DrawUtil.h>
 #include <feather-tk/core/Context.h>
+#include <feather-tk/core/Format.h>
 
 #include <optional>
 
@@ -17,7 +18,10 @@ namespace djv
     {
         struct FileButton::Private
         {
+            std::shared_ptr<ThumbnailScheduler> thumbnailScheduler;
             std::shared_ptr<FilesModelItem> item;
+            std::string text;
+            bool loading = false;
 
             struct SizeData
             {
@@ -36,7 +40,9 @@ namespace djv
                 bool init = true;
                 float scale = 1.F;
                 int height = 40;
-                tl::timelineui::ThumbnailRequest request;
+                bool visible = true;
+                int priority = 0;
+                std::future<std::shared_ptr<feather_tk::Image> > future;
                 std::shared_ptr<feather_tk::Image> image;
             };
             ThumbnailData thumbnail;
@@ -50,18 +56,21 @@ namespace djv
 
         void FileButton::_init(
             const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<ThumbnailScheduler>& thumbnailScheduler,
             const std::shared_ptr<FilesModelItem>& item,
             const std::shared_ptr<IWidget>& parent)
         {
             IButton::_init(context, "djv::app::FileButton", parent);
             FEATHER_TK_P();
-            const std::string s = feather_tk::elide(item->path.get(-1, tl::file::PathType::FileName));
-            setText(s);
+            p.text = feather_tk::elide(item->path.get(-1, tl::file::PathType::FileName));
+            setText(p.text);
             setCheckable(true);
             setHStretch(feather_tk::Stretch::Expanding);
             setAcceptsKeyFocus(true);
             _buttonRole = feather_tk::ColorRole::None;
+            p.thumbnailScheduler = thumbnailScheduler;
             p.item = item;
+            setLoading(item->loading);
         }
 
         FileButton::FileButton() :
@@ -69,18 +78,49 @@ namespace djv
         {}
 
         FileButton::~FileButton()
-        {}
+        {
+            FEATHER_TK_P();
+            p.thumbnailScheduler->cancel(reinterpret_cast<intptr_t>(this));
+        }
 
         std::shared_ptr<FileButton> FileButton::create(
             const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<ThumbnailScheduler>& thumbnailScheduler,
             const std::shared_ptr<FilesModelItem>& item,
             const std::shared_ptr<IWidget>& parent)
         {
             auto out = std::shared_ptr<FileButton>(new FileButton);
-            out->_init(context, item, parent);
+            out->_init(context, thumbnailScheduler, item, parent);
             return out;
         }
 
+        void FileButton::setLoading(bool value)
+        {
+            FEATHER_TK_P();
+            if (value != p.loading)
+            {
+                p.loading = value;
+                setText(p.loading ? feather_tk::Format("{0} (loading)").arg(p.text).str() : p.text);
+                p.size.displayScale.reset();
+                p.draw.reset();
+                _setSizeUpdate();
+                _setDrawUpdate();
+            }
+        }
+
+        void FileButton::setThumbnailPriority(int value)
+        {
+            FEATHER_TK_P();
+            if (value != p.thumbnail.priority)
+            {
+                p.thumbnail.priority = value;
+                p.thumbnailScheduler->setPriority(
+                    reinterpret_cast<intptr_t>(this),
+                    p.thumbnail.visible,
+                    p.thumbnail.priority);
+            }
+        }
+
         void FileButton::tickEvent(
             bool parentsVisible,
             bool parentsEnabled,
@@ -88,10 +128,11 @@ namespace djv
         {
             IWidget::tickEvent(parentsVisible, parentsEnabled, event);
             FEATHER_TK_P();
-            if (p.thumbnail.request.future.valid() &&
-                p.thumbnail.request.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+
+            if (p.thumbnail.future.valid() &&
+                p.thumbnail.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
             {
-                p.thumbnail.image = p.thumbnail.request.future.get();
+                p.thumbnail.image = p.thumbnail.future.get();
                 _setSizeUpdate();
                 _setDrawUpdate();
             }
@@ -124,14 +165,9 @@ namespace djv
             if (p.thumbnail.init)
             {
                 p.thumbnail.init = false;
-                if (auto context = getContext())
-                {
-                    auto thumbnailSystem = context->getSystem<tl::timelineui::ThumbnailSystem>();
-                    p.thumbnail.request = thumbnailSystem->getThumbnail(
-                        reinterpret_cast<intptr_t>(p.item.get()),
-                        p.item->path,
-                        p.thumbnail.height);
-                }
+                const intptr_t id = reinterpret_cast<intptr_t>(this);
+                p.thumbnail.future = p.thumbnailScheduler->request(id, p.item->path, p.thumbnail.height);
+                p.thumbnailScheduler->setPriority(id, p.thumbnail.visible, p.thumbnail.priority);
             }
 
             feather_tk::Size2I thumbnailSize;
@@ -162,6 +198,14 @@ namespace djv
             {
                 p.draw.reset();
             }
+            if (!clipped != p.thumbnail.visible)
+            {
+                p.thumbnail.visible = !clipped;
+                p.thumbnailScheduler->setPriority(
+                    reinterpret_cast<intptr_t>(this),
+                    p.thumbnail.visible,
+                    p.thumbnail.priority);
+            }
         }
 
         void FileButton::drawEvent(
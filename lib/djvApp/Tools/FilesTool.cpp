@@ -19,6 +19,8 @@
 #include <feather-tk/ui/Settings.h>
 #include <feather-tk/ui/ToolButton.h>
 
+#include <cstdlib>
+
 namespace djv
 {
     namespace app
@@ -46,6 +48,7 @@ namespace djv
             std::shared_ptr<feather_tk::ValueObserver<std::shared_ptr<FilesModelItem> > > aObserver;
             std::shared_ptr<feather_tk::ListObserver<std::shared_ptr<FilesModelItem> > > bObserver;
             std::shared_ptr<feather_tk::ListObserver<int> > layersObserver;
+            std::shared_ptr<feather_tk::ListObserver<bool> > loadingObserver;
             std::shared_ptr<feather_tk::ValueObserver<tl::timeline::CompareOptions> > compareObserver;
             std::shared_ptr<feather_tk::ValueObserver<tl::timeline::CompareTime> > compareTimeObserver;
         };
@@ -232,6 +235,13 @@ namespace djv
                     _layersUpdate(value);
                 });
 
+            p.loadingObserver = feather_tk::ListObserver<bool>::create(
+                app->getFilesModel()->observeLoading(),
+                [this](const std::vector<bool>& value)
+                {
+                    _loadingUpdate(value);
+                });
+
             p.compareObserver = feather_tk::ValueObserver<tl::timeline::CompareOptions>::create(
                 app->getFilesModel()->observeCompareOptions(),
                 [this](const tl::timeline::CompareOptions& value)
@@ -285,11 +295,16 @@ namespace djv
                 const auto& b = app->getFilesModel()->getB();
                 if (auto context = getContext())
                 {
+                    // The thumbnails closest to the current file are
+                    // requested first.
+                    const auto aFind = std::find(value.begin(), value.end(), a);
+                    const int aIndex = aFind != value.end() ? (aFind - value.begin()) : 0;
                     size_t row = 0;
                     for (const auto& item : value)
                     {
-                        auto aButton = FileButton::create(context, item);
+                        auto aButton = FileButton::create(context, app->getThumbnailScheduler(), item);
                         aButton->setChecked(item == a);
+                        aButton->setThumbnailPriority(std::abs(static_cast<int>(row) - aIndex));
                         aButton->setTooltip(item->path.get());
                         p.aButtons[item] = aButton;
                         p.aButtonGroup->addButton(aButton);
@@ -343,6 +358,20 @@ namespace djv
             {
                 button.second->setChecked(button.first == value);
             }
+            if (auto app = _app.lock())
+            {
+                const auto& files = app->getFilesModel()->getFiles();
+                const auto i = std::find(files.begin(), files.end(), value);
+                const int aIndex = i != files.end() ? (i - files.begin()) : 0;
+                for (size_t j = 0; j < files.size(); ++j)
+                {
+                    const auto k = p.aButtons.find(files[j]);
+                    if (k != p.aButtons.end())
+                    {
+                        k->second->setThumbnailPriority(std::abs(static_cast<int>(j) - aIndex));
+                    }
+                }
+            }
         }
 
         void FilesTool::_bUpdate(const std::vector<std::shared_ptr<FilesModelItem> >& value)
@@ -364,6 +393,29 @@ namespace djv
             }
         }
 
+        void FilesTool::_loadingUpdate(const std::vector<bool>& value)
+        {
+            FEATHER_TK_P();
+            if (auto app = _app.lock())
+            {
+                // Update the layers now that the files have been loaded.
+                const auto& files = app->getFilesModel()->getFiles();
+                for (size_t i = 0; i < value.size() && i < files.size(); ++i)
+                {
+                    const auto j = p.aButtons.find(files[i]);
+                    if (j != p.aButtons.end())
+                    {
+                        j->second->setLoading(value[i]);
+                    }
+                    if (i < p.layerComboBoxes.size())
+                    {
+                        p.layerComboBoxes[i]->setItems(files[i]->videoLayers);
+                        p.layerComboBoxes[i]->setCurrentIndex(files[i]->videoLayer);
+                    }
+                }
+            }
+        }
+
         void FilesTool::_compareUpdate(const tl::timeline::CompareOptions& value)
         {
             FEATHER_TK_P();
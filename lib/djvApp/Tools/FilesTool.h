@@ -40,6 +40,7 @@ namespace djv
             void _aUpdate(const std::shared_ptr<FilesModelItem>&);
             void _bUpdate(const std::vector<std::shared_ptr<FilesModelItem> >&);
             void _layersUpdate(const std::vector<int>&);
+            void _loadingUpdate(const std::vector<bool>&);
             void _compareUpdate(const tl::timeline::CompareOptions&);
 
             FEATHER_TK_PRIVATE();
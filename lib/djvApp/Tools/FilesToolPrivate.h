@@ -12,6 +12,8 @@ namespace djv
 {
     namespace app
     {
+        class ThumbnailScheduler;
+
         class FileButton : public feather_tk::IButton
         {
             FEATHER_TK_NON_COPYABLE(FileButton);
@@ -19,6 +21,7 @@ namespace djv
         protected:
             void _init(
                 const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<ThumbnailScheduler>&,
                 const std::shared_ptr<FilesModelItem>&,
                 const std::shared_ptr<IWidget>& parent);
 
@@ -29,9 +32,17 @@ namespace djv
 
             static std::shared_ptr<FileButton> create(
                 const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<ThumbnailScheduler>&,
                 const std::shared_ptr<FilesModelItem>&,
                 const std::shared_ptr<IWidget>& parent = nullptr);
 
+            //! Set whether the file is loading.
+            void setLoading(bool);
+
+            //! Set the thumbnail priority, lower values are requested
+            //! first.
+            void setThumbnailPriority(int);
+
             void tickEvent(
                 bool,
                 bool,
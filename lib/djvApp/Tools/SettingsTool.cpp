@@ -4,6 +4,7 @@
 
 #include <djvApp/Tools/SettingsToolPrivate.h>
 
+#include <djvApp/Models/CacheModel.h>
 #include <djvApp/Models/TimeUnitsModel.h>
 #include <djvApp/App.h>
 
@@ -164,13 +165,29 @@ namespace djv
         struct CacheSettingsWidget::Private
         {
             std::shared_ptr<SettingsModel> model;
+            std::shared_ptr<CacheModel> cacheModel;
 
             std::shared_ptr<feather_tk::FloatEdit> videoEdit;
             std::shared_ptr<feather_tk::FloatEdit> audioEdit;
             std::shared_ptr<feather_tk::FloatEdit> readBehindEdit;
+            std::shared_ptr<feather_tk::CheckBox> readAheadCheckBox;
+            std::shared_ptr<feather_tk::CheckBox> autoCheckBox;
+            std::shared_ptr<feather_tk::FloatEdit> autoPercentageEdit;
+            std::shared_ptr<feather_tk::FloatEdit> autoMaxEdit;
+            std::shared_ptr<feather_tk::Label> effectiveLabel;
+            std::shared_ptr<feather_tk::IntEdit> poolCountEdit;
+            std::shared_ptr<feather_tk::FloatEdit> poolPercentageEdit;
+            std::shared_ptr<feather_tk::CheckBox> sharedCheckBox;
+            std::shared_ptr<feather_tk::FloatEdit> sharedMaxEdit;
             std::shared_ptr<feather_tk::FormLayout> layout;
 
             std::shared_ptr<feather_tk::ValueObserver<tl::timeline::PlayerCacheOptions> > settingsObserver;
+            std::shared_ptr<feather_tk::ValueObserver<ReadAheadSettings> > readAheadSettingsObserver;
+            std::shared_ptr<feather_tk::ValueObserver<AutoCacheSettings> > autoSettingsObserver;
+            std::shared_ptr<feather_tk::ValueObserver<tl::timeline::PlayerCacheOptions> > cacheOptionsObserver;
+            std::shared_ptr<feather_tk::ValueObserver<float> > availableObserver;
+            std::shared_ptr<feather_tk::ValueObserver<PlayerPoolSettings> > poolSettingsObserver;
+            std::shared_ptr<feather_tk::ValueObserver<SharedCacheSettings> > sharedSettingsObserver;
         };
 
         void CacheSettingsWidget::_init(
@@ -182,6 +199,7 @@ namespace djv
             FEATHER_TK_P();
 
             p.model = app->getSettingsModel();
+            p.cacheModel = app->getCacheModel();
 
             p.videoEdit = feather_tk::FloatEdit::create(context);
             p.videoEdit->setRange(0.F, 1024.F);
@@ -198,12 +216,76 @@ namespace djv
             p.readBehindEdit->setStep(0.1);
             p.readBehindEdit->setLargeStep(1.0);
 
+            p.readAheadCheckBox = feather_tk::CheckBox::create(context);
+            p.readAheadCheckBox->setHStretch(feather_tk::Stretch::Expanding);
+            p.readAheadCheckBox->setTooltip(
+                "Adjust the read behind from the playback speed and loop "
+                "mode, so that the frames are cached when ping-pong "
+                "playback changes direction and when loop playback wraps "
+                "around.");
+
+            p.autoCheckBox = feather_tk::CheckBox::create(context);
+            p.autoCheckBox->setHStretch(feather_tk::Stretch::Expanding);
+            p.autoCheckBox->setTooltip(
+                "Size the video cache from the available system memory. The "
+                "size is updated periodically as the available memory changes.");
+
+            p.autoPercentageEdit = feather_tk::FloatEdit::create(context);
+            p.autoPercentageEdit->setRange(1.F, 100.F);
+            p.autoPercentageEdit->setStep(1.0);
+            p.autoPercentageEdit->setLargeStep(10.0);
+
+            p.autoMaxEdit = feather_tk::FloatEdit::create(context);
+            p.autoMaxEdit->setRange(0.F, 1024.F);
+            p.autoMaxEdit->setStep(1.0);
+            p.autoMaxEdit->setLargeStep(10.0);
+            p.autoMaxEdit->setTooltip("The maximum video cache size, zero for no maximum.");
+
+            p.effectiveLabel = feather_tk::Label::create(context);
+
+            p.poolCountEdit = feather_tk::IntEdit::create(context);
+            p.poolCountEdit->setRange(0, 16);
+            p.poolCountEdit->setTooltip(
+                "The number of recently viewed files that keep their cache, "
+                "so that switching back to them is immediate.");
+
+            p.poolPercentageEdit = feather_tk::FloatEdit::create(context);
+            p.poolPercentageEdit->setRange(0.F, 90.F);
+            p.poolPercentageEdit->setStep(1.0);
+            p.poolPercentageEdit->setLargeStep(10.0);
+            p.poolPercentageEdit->setTooltip(
+                "The percentage of the cache shared by the recently viewed files.");
+
+            p.sharedCheckBox = feather_tk::CheckBox::create(context);
+            p.sharedCheckBox->setHStretch(feather_tk::Stretch::Expanding);
+            p.sharedCheckBox->setTooltip(
+                "Share the frames decoded by exports with other instances "
+                "of the application running on this computer.");
+
+            p.sharedMaxEdit = feather_tk::FloatEdit::create(context);
+            p.sharedMaxEdit->setRange(0.F, 1024.F);
+            p.sharedMaxEdit->setStep(1.0);
+            p.sharedMaxEdit->setLargeStep(10.0);
+            p.sharedMaxEdit->setTooltip(
+                "The shared cache size. The size is set by the first "
+                "instance that uses the shared cache. It is used by exports "
+                "and is in addition to the video cache.");
+
             p.layout = feather_tk::FormLayout::create(context, shared_from_this());
             p.layout->setMarginRole(feather_tk::SizeRole::Margin);
             p.layout->setSpacingRole(feather_tk::SizeRole::SpacingSmall);
             p.layout->addRow("Video cache (GB):", p.videoEdit);
             p.layout->addRow("Audio cache (GB):", p.audioEdit);
             p.layout->addRow("Read behind (seconds):", p.readBehindEdit);
+            p.layout->addRow("Adaptive read behind:", p.readAheadCheckBox);
+            p.layout->addRow("Automatic video cache:", p.autoCheckBox);
+            p.layout->addRow("Available memory (%):", p.autoPercentageEdit);
+            p.layout->addRow("Maximum video cache (GB):", p.autoMaxEdit);
+            p.layout->addRow("Effective video cache:", p.effectiveLabel);
+            p.layout->addRow("Recent files cached:", p.poolCountEdit);
+            p.layout->addRow("Recent files cache (%):", p.poolPercentageEdit);
+            p.layout->addRow("Shared cache:", p.sharedCheckBox);
+            p.layout->addRow("Shared cache (GB):", p.sharedMaxEdit);
 
             p.settingsObserver = feather_tk::ValueObserver<tl::timeline::PlayerCacheOptions>::create(
                 p.model->observeCache(),
@@ -215,6 +297,60 @@ namespace djv
                     p.readBehindEdit->setValue(value.readBehind);
                 });
 
+            p.readAheadSettingsObserver = feather_tk::ValueObserver<ReadAheadSettings>::create(
+                p.model->observeReadAhead(),
+                [this](const ReadAheadSettings& value)
+                {
+                    _p->readAheadCheckBox->setChecked(value.enabled);
+                });
+
+            p.autoSettingsObserver = feather_tk::ValueObserver<AutoCacheSettings>::create(
+                p.model->observeAutoCache(),
+                [this](const AutoCacheSettings& value)
+                {
+                    FEATHER_TK_P();
+                    p.videoEdit->setEnabled(!value.enabled);
+                    p.autoCheckBox->setChecked(value.enabled);
+                    p.autoPercentageEdit->setValue(value.percentage);
+                    p.autoPercentageEdit->setEnabled(value.enabled);
+                    p.autoMaxEdit->setValue(value.maxGB);
+                    p.autoMaxEdit->setEnabled(value.enabled);
+                });
+
+            p.poolSettingsObserver = feather_tk::ValueObserver<PlayerPoolSettings>::create(
+                p.model->observePlayerPool(),
+                [this](const PlayerPoolSettings& value)
+                {
+                    FEATHER_TK_P();
+                    p.poolCountEdit->setValue(value.count);
+                    p.poolPercentageEdit->setValue(value.percentage);
+                    p.poolPercentageEdit->setEnabled(value.count > 0);
+                });
+
+            p.sharedSettingsObserver = feather_tk::ValueObserver<SharedCacheSettings>::create(
+                p.model->observeSharedCache(),
+                [this](const SharedCacheSettings& value)
+                {
+                    FEATHER_TK_P();
+                    p.sharedCheckBox->setChecked(value.enabled);
+                    p.sharedMaxEdit->setValue(value.maxGB);
+                    p.sharedMaxEdit->setEnabled(value.enabled);
+                });
+
+            p.cacheOptionsObserver = feather_tk::ValueObserver<tl::timeline::PlayerCacheOptions>::create(
+                p.cacheModel->observeCacheOptions(),
+                [this](const tl::timeline::PlayerCacheOptions&)
+                {
+                    _effectiveUpdate();
+                });
+
+            p.availableObserver = feather_tk::ValueObserver<float>::create(
+                p.cacheModel->observeAvailableGB(),
+                [this](float)
+                {
+                    _effectiveUpdate();
+                });
+
             p.videoEdit->setCallback(
                 [this](float value)
                 {
@@ -241,6 +377,78 @@ namespace djv
                     settings.readBehind = value;
                     p.model->setCache(settings);
                 });
+
+            p.readAheadCheckBox->setCheckedCallback(
+                [this](bool value)
+                {
+                    FEATHER_TK_P();
+                    ReadAheadSettings settings = p.model->getReadAhead();
+                    settings.enabled = value;
+                    p.model->setReadAhead(settings);
+                });
+
+            p.autoCheckBox->setCheckedCallback(
+                [this](bool value)
+                {
+                    FEATHER_TK_P();
+                    AutoCacheSettings settings = p.model->getAutoCache();
+                    settings.enabled = value;
+                    p.model->setAutoCache(settings);
+                });
+
+            p.autoPercentageEdit->setCallback(
+                [this](float value)
+                {
+                    FEATHER_TK_P();
+                    AutoCacheSettings settings = p.model->getAutoCache();
+                    settings.percentage = value;
+                    p.model->setAutoCache(settings);
+                });
+
+            p.autoMaxEdit->setCallback(
+                [this](float value)
+                {
+                    FEATHER_TK_P();
+                    AutoCacheSettings settings = p.model->getAutoCache();
+                    settings.maxGB = value;
+                    p.model->setAutoCache(settings);
+                });
+
+            p.poolCountEdit->setCallback(
+                [this](int value)
+                {
+                    FEATHER_TK_P();
+                    PlayerPoolSettings settings = p.model->getPlayerPool();
+                    settings.count = value;
+                    p.model->setPlayerPool(settings);
+                });
+
+            p.poolPercentageEdit->setCallback(
+                [this](float value)
+                {
+                    FEATHER_TK_P();
+                    PlayerPoolSettings settings = p.model->getPlayerPool();
+                    settings.percentage = value;
+                    p.model->setPlayerPool(settings);
+                });
+
+            p.sharedCheckBox->setCheckedCallback(
+                [this](bool value)
+                {
+                    FEATHER_TK_P();
+                    SharedCacheSettings settings = p.model->getSharedCache();
+                    settings.enabled = value;
+                    p.model->setSharedCache(settings);
+                });
+
+            p.sharedMaxEdit->setCallback(
+                [this](float value)
+                {
+                    FEATHER_TK_P();
+                    SharedCacheSettings settings = p.model->getSharedCache();
+                    settings.maxGB = value;
+                    p.model->setSharedCache(settings);
+                });
         }
 
         CacheSettingsWidget::CacheSettingsWidget() :
@@ -272,6 +480,15 @@ namespace djv
             _setSizeHint(_p->layout->getSizeHint());
         }
 
+        void CacheSettingsWidget::_effectiveUpdate()
+        {
+            FEATHER_TK_P();
+            p.effectiveLabel->setText(
+                feather_tk::Format("{0}GB ({1}GB available)").
+                arg(p.cacheModel->getCacheOptions().videoGB, 2).
+                arg(p.cacheModel->observeAvailableGB()->get(), 2));
+        }
+
         struct FileBrowserSettingsWidget::Private
         {
             std::shared_ptr<SettingsModel> model;
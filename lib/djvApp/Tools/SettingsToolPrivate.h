@@ -78,6 +78,8 @@ namespace djv
             void sizeHintEvent(const feather_tk::SizeHintEvent&) override;
 
         private:
+            void _effectiveUpdate();
+
             FEATHER_TK_PRIVATE();
         };
 
@@ -26,6 +26,8 @@ namespace djv
     {
         struct ToolsWidget::Private
         {
+            std::weak_ptr<App> app;
+            std::weak_ptr<MainWindow> mainWindow;
             std::map<Tool, std::shared_ptr<IToolWidget> > toolWidgets;
             std::shared_ptr<feather_tk::StackLayout> layout;
             std::shared_ptr<feather_tk::ValueObserver<Tool> > activeObserver;
@@ -43,22 +45,23 @@ namespace djv
                 parent);
             FEATHER_TK_P();
 
-            p.toolWidgets[Tool::Audio] = AudioTool::create(context, app);
-            p.toolWidgets[Tool::Color] = ColorTool::create(context, app);
-            p.toolWidgets[Tool::ColorPicker] = ColorPickerTool::create(context, app);
-            p.toolWidgets[Tool::Devices] = DevicesTool::create(context, app);
-            p.toolWidgets[Tool::Export] = ExportTool::create(context, app);
-            p.toolWidgets[Tool::Files] = FilesTool::create(context, app);
-            p.toolWidgets[Tool::Info] = InfoTool::create(context, app);
-            p.toolWidgets[Tool::Messages] = MessagesTool::create(context, app);
-            p.toolWidgets[Tool::Settings] = SettingsTool::create(context, app);
-            p.toolWidgets[Tool::SystemLog] = SystemLogTool::create(context, app);
-            p.toolWidgets[Tool::View] = ViewTool::create(context, app, mainWindow);
+            p.app = app;
+            p.mainWindow = mainWindow;
 
             p.layout = feather_tk::StackLayout::create(context, shared_from_this());
-            for (const auto& widget : p.toolWidgets)
+
+            // Create the tool widgets that are cheap or that record history
+            // (e.g., the log messages) now, the other tool widgets are
+            // created when they are first shown.
+            for (const auto tool : getToolEnums())
             {
-                widget.second->setParent(p.layout);
+                if (tool != Tool::None &&
+                    tool != Tool::Color &&
+                    tool != Tool::Export &&
+                    tool != Tool::Devices)
+                {
+                    _getToolWidget(tool);
+                }
             }
 
             p.activeObserver = feather_tk::ValueObserver<Tool>::create(
@@ -66,8 +69,8 @@ namespace djv
                 [this](Tool value)
                 {
                     FEATHER_TK_P();
-                    auto i = p.toolWidgets.find(value);
-                    p.layout->setCurrentWidget(i != p.toolWidgets.end() ? i->second : nullptr);
+                    auto widget = _getToolWidget(value);
+                    p.layout->setCurrentWidget(widget);
                     setVisible(value != Tool::None);
                 });
         }
@@ -90,6 +93,51 @@ namespace djv
             return out;
         }
 
+        std::shared_ptr<IToolWidget> ToolsWidget::_getToolWidget(Tool tool)
+        {
+            FEATHER_TK_P();
+            std::shared_ptr<IToolWidget> out;
+            const auto i = p.toolWidgets.find(tool);
+            if (i != p.toolWidgets.end())
+            {
+                out = i->second;
+            }
+            else
+            {
+                // The expensive tool widgets are created when they are first
+                // shown, so that their initialization (e.g., reading the OCIO
+                // configuration or the list of movie codecs) does not delay
+                // startup.
+                auto context = getContext();
+                auto app = p.app.lock();
+                auto mainWindow = p.mainWindow.lock();
+                if (context && app && mainWindow)
+                {
+                    switch (tool)
+                    {
+                    case Tool::Audio: out = AudioTool::create(context, app); break;
+                    case Tool::Color: out = ColorTool::create(context, app); break;
+                    case Tool::ColorPicker: out = ColorPickerTool::create(context, app); break;
+                    case Tool::Devices: out = DevicesTool::create(context, app); break;
+                    case Tool::Export: out = ExportTool::create(context, app); break;
+                    case Tool::Files: out = FilesTool::create(context, app); break;
+                    case Tool::Info: out = InfoTool::create(context, app); break;
+                    case Tool::Messages: out = MessagesTool::create(context, app); break;
+                    case Tool::Settings: out = SettingsTool::create(context, app); break;
+                    case Tool::SystemLog: out = SystemLogTool::create(context, app); break;
+                    case Tool::View: out = ViewTool::create(context, app, mainWindow); break;
+                    default: break;
+                    }
+                    if (out)
+                    {
+                        out->setParent(p.layout);
+                        p.toolWidgets[tool] = out;
+                    }
+                }
+            }
+            return out;
+        }
+
         void ToolsWidget::setGeometry(const feather_tk::Box2I & value)
         {
             IWidget::setGeometry(value);
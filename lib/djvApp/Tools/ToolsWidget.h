@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <djvApp/Models/ToolsModel.h>
+
 #include <feather-tk/ui/IWidget.h>
 
 namespace djv
@@ -11,6 +13,7 @@ namespace djv
     namespace app
     {
         class App;
+        class IToolWidget;
         class MainWindow;
 
         //! Tools widget.
@@ -41,6 +44,8 @@ namespace djv
             void sizeHintEvent(const feather_tk::SizeHintEvent&) override;
 
         private:
+            std::shared_ptr<IToolWidget> _getToolWidget(Tool);
+
             FEATHER_TK_PRIVATE();
         };
     }
@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Widgets/FrameTimingGraph.h>
+
+#include <djvApp/Models/FrameTimingModel.h>
+
+#include <algorithm>
+#include <optional>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            //! The time in milliseconds at the top of the graph.
+            const double graphMax = 50.0;
+
+            //! The width of each bar.
+            const int barWidth = 2;
+        }
+
+        struct FrameTimingGraph::Private
+        {
+            std::shared_ptr<FrameTimingModel> model;
+            uint64_t count = 0;
+            std::vector<FrameTiming> timings;
+
+            struct SizeData
+            {
+                std::optional<float> displayScale;
+                int barWidth = 0;
+            };
+            SizeData size;
+        };
+
+        void FrameTimingGraph::_init(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<FrameTimingModel>& model,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            IWidget::_init(
+                context,
+                "djv::app::FrameTimingGraph",
+                parent);
+            FEATHER_TK_P();
+            setBackgroundRole(feather_tk::ColorRole::Overlay);
+            p.model = model;
+        }
+
+        FrameTimingGraph::FrameTimingGraph() :
+            _p(new Private)
+        {}
+
+        FrameTimingGraph::~FrameTimingGraph()
+        {}
+
+        std::shared_ptr<FrameTimingGraph> FrameTimingGraph::create(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<FrameTimingModel>& model,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            auto out = std::shared_ptr<FrameTimingGraph>(new FrameTimingGraph);
+            out->_init(context, model, parent);
+            return out;
+        }
+
+        void FrameTimingGraph::tickEvent(
+            bool parentsVisible,
+            bool parentsEnabled,
+            const feather_tk::TickEvent& event)
+        {
+            IWidget::tickEvent(parentsVisible, parentsEnabled, event);
+            FEATHER_TK_P();
+            if (parentsVisible && isVisible())
+            {
+                const uint64_t count = p.model->getCount();
+                if (count != p.count)
+                {
+                    p.count = count;
+                    const int w = getGeometry().w();
+                    p.timings = p.model->get(p.size.barWidth > 0 ? (w / p.size.barWidth) : 0);
+                    _setDrawUpdate();
+                }
+            }
+        }
+
+        void FrameTimingGraph::sizeHintEvent(const feather_tk::SizeHintEvent& event)
+        {
+            IWidget::sizeHintEvent(event);
+            FEATHER_TK_P();
+            if (!p.size.displayScale.has_value() ||
+                (p.size.displayScale.has_value() && p.size.displayScale.value() != event.displayScale))
+            {
+                p.size.displayScale = event.displayScale;
+                p.size.barWidth = std::max(1, static_cast<int>(barWidth * event.displayScale));
+                p.count = 0;
+            }
+            _setSizeHint(feather_tk::Size2I(
+                p.size.barWidth * 120,
+                static_cast<int>(80 * event.displayScale)));
+        }
+
+        void FrameTimingGraph::drawEvent(
+            const feather_tk::Box2I& drawRect,
+            const feather_tk::DrawEvent& event)
+        {
+            IWidget::drawEvent(drawRect, event);
+            FEATHER_TK_P();
+            const feather_tk::Box2I& g = getGeometry();
+            struct Segment
+            {
+                FrameTimingStage begin;
+                FrameTimingStage end;
+                feather_tk::Color4F color;
+            };
+            const std::vector<Segment> segments =
+            {
+                { FrameTimingStage::Request, FrameTimingStage::Video, feather_tk::Color4F(.9F, .4F, .3F) },
+                { FrameTimingStage::Video, FrameTimingStage::DrawBegin, feather_tk::Color4F(.5F, .5F, .5F) },
+                { FrameTimingStage::DrawBegin, FrameTimingStage::DrawEnd, feather_tk::Color4F(.4F, .8F, .4F) },
+                { FrameTimingStage::DrawEnd, FrameTimingStage::Present, feather_tk::Color4F(.4F, .6F, .9F) }
+            };
+            int x = g.max.x + 1 - static_cast<int>(p.timings.size()) * p.size.barWidth;
+            for (const auto& timing : p.timings)
+            {
+                double t = 0.0;
+                for (const auto& segment : segments)
+                {
+                    const double elapsed = timing.getElapsed(segment.begin, segment.end);
+                    if (elapsed > 0.0)
+                    {
+                        const int y0 = g.max.y - static_cast<int>(std::min(t / graphMax, 1.0) * g.h());
+                        t += elapsed;
+                        const int y1 = g.max.y - static_cast<int>(std::min(t / graphMax, 1.0) * g.h());
+                        if (y0 > y1)
+                        {
+                            event.render->drawRect(
+                                feather_tk::Box2I(x, y1, p.size.barWidth, y0 - y1),
+                                segment.color);
+                        }
+                    }
+                }
+                x += p.size.barWidth;
+            }
+        }
+    }
+}
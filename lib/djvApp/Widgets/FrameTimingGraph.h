@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/ui/IWidget.h>
+
+namespace djv
+{
+    namespace app
+    {
+        class FrameTimingModel;
+
+        //! Frame timing graph.
+        //!
+        //! Each frame is drawn as a bar, with the time spent waiting for
+        //! the video, waiting for the draw, rendering, and presenting
+        //! stacked from the bottom.
+        class FrameTimingGraph : public feather_tk::IWidget
+        {
+            FEATHER_TK_NON_COPYABLE(FrameTimingGraph);
+
+        protected:
+            void _init(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<FrameTimingModel>&,
+                const std::shared_ptr<IWidget>& parent);
+
+            FrameTimingGraph();
+
+        public:
+            ~FrameTimingGraph();
+
+            static std::shared_ptr<FrameTimingGraph> create(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<FrameTimingModel>&,
+                const std::shared_ptr<IWidget>& parent = nullptr);
+
+            void tickEvent(
+                bool,
+                bool,
+                const feather_tk::TickEvent&) override;
+            void sizeHintEvent(const feather_tk::SizeHintEvent&) override;
+            void drawEvent(const feather_tk::Box2I&, const feather_tk::DrawEvent&) override;
+
+        private:
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
@@ -4,21 +4,29 @@
 
 #include <djvApp//Widgets/Viewport.h>
 
+#include <djvApp/Models/CacheModel.h>
 #include <djvApp/Models/ColorModel.h>
 #include <djvApp/Models/FilesModel.h>
+#include <djvApp/Models/FrameTimingModel.h>
 #include <djvApp/Models/SettingsModel.h>
 #include <djvApp/Models/TimeUnitsModel.h>
 #include <djvApp/Models/ViewportModel.h>
+#include <djvApp/Widgets/FrameTimingGraph.h>
 #include <djvApp/App.h>
 
+#include <tlTimelineUI/ThumbnailSystem.h>
+
+#include <tlTimeline/IRender.h>
 #include <tlTimeline/Util.h>
 
+#include <feather-tk/gl/OffscreenBuffer.h>
 #include <feather-tk/ui/ColorSwatch.h>
 #include <feather-tk/ui/GridLayout.h>
 #include <feather-tk/ui/Label.h>
 #include <feather-tk/ui/RowLayout.h>
 #include <feather-tk/ui/Spacer.h>
 #include <feather-tk/core/Format.h>
+#include <feather-tk/core/RenderUtil.h>
 
 #include <regex>
 
@@ -26,32 +34,51 @@ namespace djv
 {
     namespace app
     {
+        namespace
+        {
+            //! The height of the reduced resolution frames shown while
+            //! scrubbing.
+            const int scrubHeight = 360;
+        }
+
         struct Viewport::Private
         {
             std::weak_ptr<App> app;
             bool hud = false;
             tl::file::Path path;
+            tl::io::Options ioOptions;
             OTIO_NS::RationalTime currentTime = tl::time::invalidTime;
             double fps = 0.0;
             size_t droppedFrames = 0;
             size_t videoDataSize = 0;
             feather_tk::ImageOptions imageOptions;
             tl::timeline::DisplayOptions displayOptions;
+            tl::timeline::OCIOOptions ocioOptions;
+            tl::timeline::LUTOptions lutOptions;
+            feather_tk::ImageType colorBuffer = feather_tk::ImageType::RGBA_U8;
             feather_tk::Color4F colorPicker;
             tl::timeline::PlayerCacheInfo cacheInfo;
+            float cacheVideoGB = 0.F;
             MouseActionBinding colorPickerBinding = MouseActionBinding(0);
             MouseActionBinding frameShuttleBinding = MouseActionBinding(0, feather_tk::KeyModifier::Shift);
+            std::shared_ptr<FrameTimingModel> frameTimingModel;
+            FrameTiming frameTiming;
+            bool frameGraph = false;
 
             std::shared_ptr<feather_tk::Label> fileNameLabel;
             std::shared_ptr<feather_tk::Label> timeLabel;
             std::shared_ptr<feather_tk::ColorSwatch> colorPickerSwatch;
             std::shared_ptr<feather_tk::Label> colorPickerLabel;
             std::shared_ptr<feather_tk::Label> cacheLabel;
+            std::shared_ptr<feather_tk::Label> frameTimingLabel;
+            std::shared_ptr<FrameTimingGraph> frameTimingGraph;
+            std::shared_ptr<feather_tk::VerticalLayout> frameTimingLayout;
             std::shared_ptr<feather_tk::GridLayout> hudLayout;
 
             std::shared_ptr<feather_tk::ValueObserver<OTIO_NS::RationalTime> > currentTimeObserver;
             std::shared_ptr<feather_tk::ListObserver<tl::timeline::VideoData> > videoDataObserver;
             std::shared_ptr<feather_tk::ValueObserver<tl::timeline::PlayerCacheInfo> > cacheObserver;
+            std::shared_ptr<feather_tk::ValueObserver<tl::timeline::PlayerCacheOptions> > cacheOptionsObserver;
             std::shared_ptr<feather_tk::ValueObserver<double> > fpsObserver;
             std::shared_ptr<feather_tk::ValueObserver<size_t> > droppedFramesObserver;
             std::shared_ptr<feather_tk::ValueObserver<tl::timeline::CompareOptions> > compareOptionsObserver;
@@ -64,6 +91,7 @@ namespace djv
             std::shared_ptr<feather_tk::ValueObserver<tl::timeline::ForegroundOptions> > fgOptionsObserver;
             std::shared_ptr<feather_tk::ValueObserver<feather_tk::ImageType> > colorBufferObserver;
             std::shared_ptr<feather_tk::ValueObserver<bool> > hudObserver;
+            std::shared_ptr<feather_tk::ValueObserver<bool> > frameGraphObserver;
             std::shared_ptr<feather_tk::ValueObserver<tl::timeline::TimeUnits> > timeUnitsObserver;
             std::shared_ptr<feather_tk::ValueObserver<MouseSettings> > mouseSettingsObserver;
 
@@ -79,6 +107,21 @@ namespace djv
                 OTIO_NS::RationalTime shuttleStart = tl::time::invalidTime;
             };
             MouseData mouse;
+
+            struct ScrubData
+            {
+                bool timeline = false;
+                OTIO_NS::RationalTime videoTime = tl::time::invalidTime;
+                feather_tk::Size2I videoSize;
+                float pixelAspectRatio = 1.F;
+                OTIO_NS::RationalTime requestTime = tl::time::invalidTime;
+                tl::timelineui::ThumbnailRequest request;
+                OTIO_NS::RationalTime imageTime = tl::time::invalidTime;
+                std::shared_ptr<feather_tk::Image> image;
+                std::shared_ptr<feather_tk::gl::OffscreenBuffer> buffer;
+                bool bufferUpdate = false;
+            };
+            ScrubData scrub;
         };
 
         void Viewport::_init(
@@ -93,6 +136,7 @@ namespace djv
             _setMousePressEnabled(true);
 
             p.app = app;
+            p.frameTimingModel = app->getFrameTimingModel();
 
             p.fileNameLabel = feather_tk::Label::create(context);
             p.fileNameLabel->setFontRole(feather_tk::FontRole::Mono);
@@ -116,6 +160,14 @@ namespace djv
             p.cacheLabel->setBackgroundRole(feather_tk::ColorRole::Overlay);
             p.cacheLabel->setHAlign(feather_tk::HAlign::Right);
 
+            p.frameTimingLabel = feather_tk::Label::create(context);
+            p.frameTimingLabel->setFontRole(feather_tk::FontRole::Mono);
+            p.frameTimingLabel->setMarginRole(feather_tk::SizeRole::MarginInside);
+            p.frameTimingLabel->setBackgroundRole(feather_tk::ColorRole::Overlay);
+            p.frameTimingLabel->setHAlign(feather_tk::HAlign::Right);
+            p.frameTimingGraph = FrameTimingGraph::create(context, p.frameTimingModel);
+            p.frameTimingGraph->setHAlign(feather_tk::HAlign::Right);
+
             p.hudLayout = feather_tk::GridLayout::create(context, shared_from_this());
             p.hudLayout->setMarginRole(feather_tk::SizeRole::MarginSmall);
             p.hudLayout->setSpacingRole(feather_tk::SizeRole::SpacingSmall);
@@ -128,6 +180,13 @@ namespace djv
             spacer->setStretch(feather_tk::Stretch::Expanding);
             p.hudLayout->setGridPos(spacer, 1, 1);
 
+            p.frameTimingLayout = feather_tk::VerticalLayout::create(context, p.hudLayout);
+            p.frameTimingLayout->setSpacingRole(feather_tk::SizeRole::None);
+            p.frameTimingLayout->setVAlign(feather_tk::VAlign::Top);
+            p.hudLayout->setGridPos(p.frameTimingLayout, 1, 2);
+            p.frameTimingLabel->setParent(p.frameTimingLayout);
+            p.frameTimingGraph->setParent(p.frameTimingLayout);
+
             auto hLayout = feather_tk::HorizontalLayout::create(context, p.hudLayout);
             p.hudLayout->setGridPos(hLayout, 2, 0);
             hLayout->setMarginRole(feather_tk::SizeRole::MarginInside);
@@ -165,14 +224,18 @@ namespace djv
                 app->getColorModel()->observeOCIOOptions(),
                 [this](const tl::timeline::OCIOOptions& value)
                 {
-                   setOCIOOptions(value);
+                    _p->ocioOptions = value;
+                    _p->scrub.bufferUpdate = true;
+                    setOCIOOptions(value);
                 });
 
             p.lutOptionsObserver = feather_tk::ValueObserver<tl::timeline::LUTOptions>::create(
                 app->getColorModel()->observeLUTOptions(),
                 [this](const tl::timeline::LUTOptions& value)
                 {
-                   setLUTOptions(value);
+                    _p->lutOptions = value;
+                    _p->scrub.bufferUpdate = true;
+                    setLUTOptions(value);
                 });
 
             p.colorPickerObserver = feather_tk::ValueObserver<feather_tk::Color4F>::create(
@@ -188,6 +251,7 @@ namespace djv
                 [this](const feather_tk::ImageOptions& value)
                 {
                     _p->imageOptions = value;
+                    _p->scrub.bufferUpdate = true;
                     _videoDataUpdate();
                 });
 
@@ -196,6 +260,7 @@ namespace djv
                 [this](const tl::timeline::DisplayOptions& value)
                 {
                     _p->displayOptions = value;
+                    _p->scrub.bufferUpdate = true;
                     _videoDataUpdate();
                 });
 
@@ -217,6 +282,8 @@ namespace djv
                 app->getViewportModel()->observeColorBuffer(),
                 [this](feather_tk::ImageType value)
                 {
+                    _p->colorBuffer = value;
+                    _p->scrub.bufferUpdate = true;
                     setColorBuffer(value);
                     _hudUpdate();
                 });
@@ -229,6 +296,22 @@ namespace djv
                     _hudUpdate();
                 });
 
+            p.frameGraphObserver = feather_tk::ValueObserver<bool>::create(
+                app->getViewportModel()->observeFrameGraph(),
+                [this](bool value)
+                {
+                    _p->frameGraph = value;
+                    _hudUpdate();
+                });
+
+            p.cacheOptionsObserver = feather_tk::ValueObserver<tl::timeline::PlayerCacheOptions>::create(
+                app->getCacheModel()->observeCacheOptions(),
+                [this](const tl::timeline::PlayerCacheOptions& value)
+                {
+                    _p->cacheVideoGB = value.videoGB;
+                    _hudUpdate();
+                });
+
             p.timeUnitsObserver = feather_tk::ValueObserver<tl::timeline::TimeUnits>::create(
                 app->getTimeUnitsModel()->observeTimeUnits(),
                 [this](tl::timeline::TimeUnits value)
@@ -276,15 +359,31 @@ namespace djv
         {
             tl::timelineui::Viewport::setPlayer(player);
             FEATHER_TK_P();
+            p.scrub = Private::ScrubData();
             if (player)
             {
                 p.path = player->getPath();
+                p.ioOptions = player->getTimeline()->getOptions().ioOptions;
 
                 p.currentTimeObserver = feather_tk::ValueObserver<OTIO_NS::RationalTime>::create(
                     player->observeCurrentTime(),
                     [this](const OTIO_NS::RationalTime& value)
                     {
-                        _p->currentTime = value;
+                        FEATHER_TK_P();
+                        p.currentTime = value;
+
+                        // Start the timing for the new frame. Frames that
+                        // were not presented (e.g., dropped frames) are
+                        // added with the stages that were recorded.
+                        if (p.frameTiming.has(FrameTimingStage::Request))
+                        {
+                            p.frameTimingModel->add(p.frameTiming);
+                        }
+                        p.frameTiming = FrameTiming();
+                        p.frameTiming.frame = value.value();
+                        p.frameTiming.set(FrameTimingStage::Request);
+
+                        _scrubUpdate();
                         _hudUpdate();
                     });
 
@@ -292,7 +391,24 @@ namespace djv
                     player->observeCurrentVideo(),
                     [this](const std::vector<tl::timeline::VideoData>& value)
                     {
-                        _p->videoDataSize = value.size();
+                        FEATHER_TK_P();
+                        p.videoDataSize = value.size();
+                        if (!value.empty())
+                        {
+                            p.scrub.videoTime = value.front().time;
+                            p.scrub.videoSize = value.front().size;
+                            if (!value.front().layers.empty() && value.front().layers.front().image)
+                            {
+                                p.scrub.pixelAspectRatio =
+                                    value.front().layers.front().image->getInfo().pixelAspectRatio;
+                            }
+                        }
+                        if (!value.empty() &&
+                            p.frameTiming.has(FrameTimingStage::Request) &&
+                            !p.frameTiming.has(FrameTimingStage::Video))
+                        {
+                            p.frameTiming.set(FrameTimingStage::Video);
+                        }
                         _videoDataUpdate();
                     });
 
@@ -307,6 +423,7 @@ namespace djv
             else
             {
                 p.path = tl::file::Path();
+                p.ioOptions = tl::io::Options();
                 p.currentTime = tl::time::invalidTime;
                 p.currentTimeObserver.reset();
                 p.videoDataObserver.reset();
@@ -317,6 +434,13 @@ namespace djv
             }
         }
 
+        void Viewport::setScrub(bool value)
+        {
+            FEATHER_TK_P();
+            p.scrub.timeline = value;
+            _scrubUpdate();
+        }
+
         void Viewport::setGeometry(const feather_tk::Box2I& value)
         {
             tl::timelineui::Viewport::setGeometry(value);
@@ -324,6 +448,35 @@ namespace djv
             p.hudLayout->setGeometry(value);
         }
 
+        void Viewport::tickEvent(
+            bool parentsVisible,
+            bool parentsEnabled,
+            const feather_tk::TickEvent& event)
+        {
+            tl::timelineui::Viewport::tickEvent(parentsVisible, parentsEnabled, event);
+            FEATHER_TK_P();
+
+            // The window is drawn and swapped after the widgets are ticked,
+            // so the frame has been presented by the next tick.
+            if (p.frameTiming.has(FrameTimingStage::DrawEnd) &&
+                !p.frameTiming.has(FrameTimingStage::Present))
+            {
+                p.frameTiming.set(FrameTimingStage::Present);
+                p.frameTimingModel->add(p.frameTiming);
+                p.frameTiming = FrameTiming();
+            }
+
+            if (p.scrub.request.future.valid() &&
+                p.scrub.request.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                p.scrub.image = p.scrub.request.future.get();
+                p.scrub.imageTime = p.scrub.requestTime;
+                p.scrub.bufferUpdate = true;
+                _setDrawUpdate();
+                _scrubUpdate();
+            }
+        }
+
         void Viewport::sizeHintEvent(const feather_tk::SizeHintEvent& event)
         {
             tl::timelineui::Viewport::sizeHintEvent(event);
@@ -331,6 +484,57 @@ namespace djv
             _setSizeHint(p.hudLayout->getSizeHint());
         }
 
+        void Viewport::drawEvent(
+            const feather_tk::Box2I& drawRect,
+            const feather_tk::DrawEvent& event)
+        {
+            FEATHER_TK_P();
+            const bool timing =
+                p.frameTiming.has(FrameTimingStage::Video) &&
+                !p.frameTiming.has(FrameTimingStage::DrawBegin);
+            if (timing)
+            {
+                p.frameTiming.set(FrameTimingStage::DrawBegin);
+            }
+            tl::timelineui::Viewport::drawEvent(drawRect, event);
+
+            // Draw the reduced resolution frame over the previous frame
+            // until the full resolution frame is available. The frame is
+            // rendered with the same color and display options as the
+            // full resolution frames.
+            if (1 == p.videoDataSize &&
+                p.scrub.image &&
+                p.scrub.imageTime == p.currentTime &&
+                p.scrub.videoTime != p.currentTime)
+            {
+                if (auto render = std::dynamic_pointer_cast<tl::timeline::IRender>(event.render))
+                {
+                    if (p.scrub.bufferUpdate || !p.scrub.buffer)
+                    {
+                        _scrubRender(render);
+                    }
+                    if (p.scrub.buffer)
+                    {
+                        const feather_tk::Box2I& g = getGeometry();
+                        const feather_tk::V2I& pos = getViewPos();
+                        const double zoom = getViewZoom();
+                        render->drawTexture(
+                            p.scrub.buffer->getColorID(),
+                            feather_tk::Box2I(
+                                g.min.x + pos.x,
+                                g.min.y + pos.y,
+                                p.scrub.videoSize.w * p.scrub.pixelAspectRatio * zoom,
+                                p.scrub.videoSize.h * zoom));
+                    }
+                }
+            }
+
+            if (timing)
+            {
+                p.frameTiming.set(FrameTimingStage::DrawEnd);
+            }
+        }
+
         void Viewport::mouseMoveEvent(feather_tk::MouseMoveEvent& event)
         {
             tl::timelineui::Viewport::mouseMoveEvent(event);
@@ -391,6 +595,7 @@ namespace djv
                     player->stop();
                     p.mouse.shuttleStart = player->getCurrentTime();
                 }
+                _scrubUpdate();
             }
         }
 
@@ -399,6 +604,7 @@ namespace djv
             tl::timelineui::Viewport::mouseReleaseEvent(event);
             FEATHER_TK_P();
             p.mouse = Private::MouseData();
+            _scrubUpdate();
         }
 
         void Viewport::_videoDataUpdate()
@@ -415,6 +621,87 @@ namespace djv
             setDisplayOptions(displayOptions);
         }
 
+        void Viewport::_scrubUpdate()
+        {
+            FEATHER_TK_P();
+
+            // Only one reduced resolution frame is requested at a time, so
+            // the requests do not fall behind the scrubbing.
+            const bool scrub = p.scrub.timeline || Private::MouseMode::Shuttle == p.mouse.mode;
+            if (scrub &&
+                !p.scrub.request.future.valid() &&
+                !p.path.isEmpty() &&
+                !p.currentTime.strictly_equal(tl::time::invalidTime) &&
+                p.currentTime != p.scrub.requestTime &&
+                p.currentTime != p.scrub.videoTime)
+            {
+                if (auto context = getContext())
+                {
+                    auto thumbnailSystem = context->getSystem<tl::timelineui::ThumbnailSystem>();
+                    p.scrub.requestTime = p.currentTime;
+                    p.scrub.request = thumbnailSystem->getThumbnail(
+                        reinterpret_cast<intptr_t>(this),
+                        p.path,
+                        scrubHeight,
+                        p.currentTime,
+                        p.ioOptions);
+                }
+            }
+        }
+
+        void Viewport::_scrubRender(const std::shared_ptr<tl::timeline::IRender>& render)
+        {
+            FEATHER_TK_P();
+            p.scrub.bufferUpdate = false;
+            const feather_tk::Size2I& size = p.scrub.image->getSize();
+            feather_tk::gl::OffscreenBufferOptions options;
+            options.color = p.colorBuffer;
+            if (feather_tk::gl::doCreate(p.scrub.buffer, size, options))
+            {
+                p.scrub.buffer = feather_tk::gl::OffscreenBuffer::create(size, options);
+            }
+            if (p.scrub.buffer)
+            {
+                const feather_tk::RenderSizeState renderSizeState(render);
+                const feather_tk::ViewportState viewportState(render);
+                const feather_tk::ClipRectEnabledState clipRectEnabledState(render);
+                const feather_tk::ClipRectState clipRectState(render);
+                const feather_tk::TransformState transformState(render);
+                const feather_tk::gl::OffscreenBufferBinding binding(p.scrub.buffer);
+                render->setRenderSize(size);
+                render->setViewport(feather_tk::Box2I(0, 0, size.w, size.h));
+                render->setClipRectEnabled(false);
+
+                // The frame is mirrored with the projection, the same as
+                // the full resolution frames.
+                const float w = size.w;
+                const float h = size.h;
+                render->setTransform(feather_tk::ortho(
+                    p.displayOptions.mirror.x ? w : 0.F,
+                    p.displayOptions.mirror.x ? 0.F : w,
+                    p.displayOptions.mirror.y ? h : 0.F,
+                    p.displayOptions.mirror.y ? 0.F : h,
+                    -1.F,
+                    1.F));
+                render->clearViewport(feather_tk::Color4F(0.F, 0.F, 0.F, 0.F));
+                render->setOCIOOptions(p.ocioOptions);
+                render->setLUTOptions(p.lutOptions);
+                tl::timeline::VideoData video;
+                video.size = size;
+                video.time = p.scrub.imageTime;
+                tl::timeline::VideoLayer layer;
+                layer.image = p.scrub.image;
+                video.layers.push_back(layer);
+                render->drawVideo(
+                    { video },
+                    { feather_tk::Box2I(0, 0, size.w, size.h) },
+                    { p.imageOptions },
+                    { p.displayOptions },
+                    tl::timeline::CompareOptions(),
+                    p.colorBuffer);
+            }
+        }
+
         void Viewport::_hudUpdate()
         {
             FEATHER_TK_P();
@@ -441,10 +728,42 @@ namespace djv
                 arg(p.colorPicker.a, 2));
 
             p.cacheLabel->setText(
-                feather_tk::Format("Cache: {0}% V, {1}% A").
+                feather_tk::Format("Cache: {0}% V of {1}GB, {2}% A").
                 arg(static_cast<int>(p.cacheInfo.videoPercentage)).
+                arg(p.cacheVideoGB, 2).
                 arg(static_cast<int>(p.cacheInfo.audioPercentage)));
 
+            if (p.hud && p.frameGraph)
+            {
+                // Average the recent frames that were presented.
+                double frame = 0.0;
+                double decode = 0.0;
+                double render = 0.0;
+                size_t count = 0;
+                for (const auto& timing : p.frameTimingModel->get(60))
+                {
+                    if (timing.has(FrameTimingStage::Present))
+                    {
+                        frame += timing.getElapsed(FrameTimingStage::Request, FrameTimingStage::Present);
+                        decode += timing.getElapsed(FrameTimingStage::Request, FrameTimingStage::Video);
+                        render += timing.getElapsed(FrameTimingStage::DrawBegin, FrameTimingStage::DrawEnd);
+                        ++count;
+                    }
+                }
+                if (count > 0)
+                {
+                    frame /= count;
+                    decode /= count;
+                    render /= count;
+                }
+                p.frameTimingLabel->setText(
+                    feather_tk::Format("Frame: {0}ms, decode: {1}ms, render: {2}ms").
+                    arg(frame, 2).
+                    arg(decode, 2).
+                    arg(render, 2));
+            }
+            p.frameTimingLayout->setVisible(p.frameGraph);
+
             p.hudLayout->setVisible(p.hud);
         }
     }
@@ -6,6 +6,14 @@
 
 #include <tlTimelineUI/Viewport.h>
 
+namespace tl
+{
+    namespace timeline
+    {
+        class IRender;
+    }
+}
+
 namespace djv
 {
     namespace app
@@ -35,14 +43,26 @@ namespace djv
 
             void setPlayer(const std::shared_ptr<tl::timeline::Player>&) override;
 
+            //! Set whether the timeline is being scrubbed. While scrubbing,
+            //! a reduced resolution frame is shown until the full
+            //! resolution frame is available.
+            void setScrub(bool);
+
             void setGeometry(const feather_tk::Box2I&) override;
+            void tickEvent(
+                bool,
+                bool,
+                const feather_tk::TickEvent&) override;
             void sizeHintEvent(const feather_tk::SizeHintEvent&) override;
+            void drawEvent(const feather_tk::Box2I&, const feather_tk::DrawEvent&) override;
             void mouseMoveEvent(feather_tk::MouseMoveEvent&) override;
             void mousePressEvent(feather_tk::MouseClickEvent&) override;
             void mouseReleaseEvent(feather_tk::MouseClickEvent&) override;
 
         private:
             void _videoDataUpdate();
+            void _scrubUpdate();
+            void _scrubRender(const std::shared_ptr<tl::timeline::IRender>&);
             void _hudUpdate();
 
             FEATHER_TK_PRIVATE();
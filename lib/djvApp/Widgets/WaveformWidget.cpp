@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvApp/Widgets/WaveformWidget.h>
+
+#include <djvApp/Models/FilesModel.h>
+#include <djvApp/Models/WaveformModel.h>
+#include <djvApp/App.h>
+
+#include <optional>
+
+namespace djv
+{
+    namespace app
+    {
+        struct WaveformWidget::Private
+        {
+            std::shared_ptr<WaveformModel> model;
+            std::future<std::shared_ptr<Waveform> > future;
+            std::shared_ptr<Waveform> waveform;
+            std::vector<WaveformPeak> peaks;
+            OTIO_NS::TimeRange timeRange = tl::time::invalidTimeRange;
+            OTIO_NS::RationalTime currentTime = tl::time::invalidTime;
+
+            struct SizeData
+            {
+                std::optional<float> displayScale;
+                int lineWidth = 0;
+            };
+            SizeData size;
+
+            std::shared_ptr<feather_tk::ValueObserver<std::shared_ptr<FilesModelItem> > > aObserver;
+            std::shared_ptr<feather_tk::ValueObserver<std::shared_ptr<tl::timeline::Player> > > playerObserver;
+            std::shared_ptr<feather_tk::ValueObserver<OTIO_NS::RationalTime> > currentTimeObserver;
+        };
+
+        void WaveformWidget::_init(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            IWidget::_init(
+                context,
+                "djv::app::WaveformWidget",
+                parent);
+            FEATHER_TK_P();
+            setBackgroundRole(feather_tk::ColorRole::Base);
+            p.model = app->getWaveformModel();
+
+            p.aObserver = feather_tk::ValueObserver<std::shared_ptr<FilesModelItem> >::create(
+                app->getFilesModel()->observeA(),
+                [this](const std::shared_ptr<FilesModelItem>& value)
+                {
+                    FEATHER_TK_P();
+                    p.future = std::future<std::shared_ptr<Waveform> >();
+                    p.waveform.reset();
+                    p.peaks.clear();
+                    if (value)
+                    {
+                        p.future = p.model->get(
+                            value->audioPath.isEmpty() ? value->path : value->audioPath);
+                    }
+                    _setDrawUpdate();
+                });
+
+            p.playerObserver = feather_tk::ValueObserver<std::shared_ptr<tl::timeline::Player> >::create(
+                app->observePlayer(),
+                [this](const std::shared_ptr<tl::timeline::Player>& value)
+                {
+                    FEATHER_TK_P();
+                    p.timeRange = value ? value->getTimeRange() : tl::time::invalidTimeRange;
+                    p.currentTime = tl::time::invalidTime;
+                    p.currentTimeObserver.reset();
+                    if (value)
+                    {
+                        p.currentTimeObserver = feather_tk::ValueObserver<OTIO_NS::RationalTime>::create(
+                            value->observeCurrentTime(),
+                            [this](const OTIO_NS::RationalTime& value)
+                            {
+                                _p->currentTime = value;
+                                _setDrawUpdate();
+                            });
+                    }
+                    _setDrawUpdate();
+                });
+        }
+
+        WaveformWidget::WaveformWidget() :
+            _p(new Private)
+        {}
+
+        WaveformWidget::~WaveformWidget()
+        {}
+
+        std::shared_ptr<WaveformWidget> WaveformWidget::create(
+            const std::shared_ptr<feather_tk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            auto out = std::shared_ptr<WaveformWidget>(new WaveformWidget);
+            out->_init(context, app, parent);
+            return out;
+        }
+
+        void WaveformWidget::setGeometry(const feather_tk::Box2I& value)
+        {
+            const bool changed = value.w() != getGeometry().w();
+            IWidget::setGeometry(value);
+            FEATHER_TK_P();
+            if (changed && p.waveform)
+            {
+                p.peaks = p.waveform->getPeaks(p.waveform->timeRange, value.w());
+            }
+        }
+
+        void WaveformWidget::tickEvent(
+            bool parentsVisible,
+            bool parentsEnabled,
+            const feather_tk::TickEvent& event)
+        {
+            IWidget::tickEvent(parentsVisible, parentsEnabled, event);
+            FEATHER_TK_P();
+            if (p.future.valid() &&
+                p.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                p.waveform = p.future.get();
+                p.peaks.clear();
+                if (p.waveform)
+                {
+                    p.peaks = p.waveform->getPeaks(p.waveform->timeRange, getGeometry().w());
+                }
+                _setDrawUpdate();
+            }
+        }
+
+        void WaveformWidget::sizeHintEvent(const feather_tk::SizeHintEvent& event)
+        {
+            IWidget::sizeHintEvent(event);
+            FEATHER_TK_P();
+            if (!p.size.displayScale.has_value() ||
+                (p.size.displayScale.has_value() && p.size.displayScale.value() != event.displayScale))
+            {
+                p.size.displayScale = event.displayScale;
+                p.size.lineWidth = std::max(1, static_cast<int>(event.displayScale));
+            }
+            _setSizeHint(feather_tk::Size2I(
+                static_cast<int>(200 * event.displayScale),
+                static_cast<int>(60 * event.displayScale)));
+        }
+
+        void WaveformWidget::drawEvent(
+            const feather_tk::Box2I& drawRect,
+            const feather_tk::DrawEvent& event)
+        {
+            IWidget::drawEvent(drawRect, event);
+            FEATHER_TK_P();
+            const feather_tk::Box2I& g = getGeometry();
+            const int y = g.center().y;
+            const float h = g.h() / 2.F;
+            const feather_tk::Color4F color = event.style->getColorRole(feather_tk::ColorRole::Text);
+            for (size_t i = 0; i < p.peaks.size(); ++i)
+            {
+                const int y0 = y - static_cast<int>(p.peaks[i].max * h);
+                const int y1 = y - static_cast<int>(p.peaks[i].min * h);
+                event.render->drawRect(
+                    feather_tk::Box2I(g.min.x + i, y0, 1, std::max(1, y1 - y0)),
+                    color);
+            }
+
+            // Draw the current time relative to the start of the timeline.
+            if (p.waveform &&
+                p.timeRange != tl::time::invalidTimeRange &&
+                p.currentTime != tl::time::invalidTime)
+            {
+                const double duration = p.waveform->timeRange.duration().to_seconds();
+                if (duration > 0.0)
+                {
+                    const double t =
+                        (p.currentTime - p.timeRange.start_time()).to_seconds() / duration;
+                    event.render->drawRect(
+                        feather_tk::Box2I(
+                            g.min.x + static_cast<int>(t * g.w()),
+                            g.min.y,
+                            p.size.lineWidth,
+                            g.h()),
+                        event.style->getColorRole(feather_tk::ColorRole::Red));
+                }
+            }
+        }
+    }
+}
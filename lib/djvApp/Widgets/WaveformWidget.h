@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/ui/IWidget.h>
+
+namespace djv
+{
+    namespace app
+    {
+        class App;
+
+        //! Waveform widget.
+        //!
+        //! This shows the audio waveform of the current file, with a line
+        //! at the current time.
+        class WaveformWidget : public feather_tk::IWidget
+        {
+            FEATHER_TK_NON_COPYABLE(WaveformWidget);
+
+        protected:
+            void _init(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<App>&,
+                const std::shared_ptr<IWidget>& parent);
+
+            WaveformWidget();
+
+        public:
+            ~WaveformWidget();
+
+            static std::shared_ptr<WaveformWidget> create(
+                const std::shared_ptr<feather_tk::Context>&,
+                const std::shared_ptr<App>&,
+                const std::shared_ptr<IWidget>& parent = nullptr);
+
+            void setGeometry(const feather_tk::Box2I&) override;
+            void tickEvent(
+                bool,
+                bool,
+                const feather_tk::TickEvent&) override;
+            void sizeHintEvent(const feather_tk::SizeHintEvent&) override;
+            void drawEvent(const feather_tk::Box2I&, const feather_tk::DrawEvent&) override;
+
+        private:
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvAppTest/FrameCacheModelTest.h>
+
+#include <djvApp/Models/FrameCacheModel.h>
+
+#include <sstream>
+
+namespace djv
+{
+    namespace app_tests
+    {
+        FrameCacheModelTest::FrameCacheModelTest() :
+            ITest("djv::app_tests::FrameCacheModelTest")
+        {}
+
+        FrameCacheModelTest::~FrameCacheModelTest()
+        {}
+
+        std::shared_ptr<FrameCacheModelTest> FrameCacheModelTest::create()
+        {
+            return std::shared_ptr<FrameCacheModelTest>(new FrameCacheModelTest);
+        }
+
+        void FrameCacheModelTest::run()
+        {
+            _key();
+            _reference();
+            _lru();
+            _remove();
+        }
+
+        namespace
+        {
+            tl::timeline::VideoData getVideo(
+                const std::shared_ptr<feather_tk::Image>& image,
+                double time)
+            {
+                tl::timeline::VideoData out;
+                out.time = OTIO_NS::RationalTime(time, 24.0);
+                tl::timeline::VideoLayer layer;
+                layer.image = image;
+                out.layers.push_back(layer);
+                return out;
+            }
+        }
+
+        void FrameCacheModelTest::_key()
+        {
+            // The file does not exist, so the file stamp does not change.
+            const tl::file::Path path("djvAppTest_FrameCacheModelTest.mov");
+            const OTIO_NS::RationalTime time(1.0, 24.0);
+            tl::io::Options options;
+            options["Option"] = "1";
+            const std::string key = app::getFrameCacheKey(path, 0, time, options);
+            DJV_ASSERT(0 == key.compare(0, path.get().size() + 1, path.get() + ";"));
+            DJV_ASSERT(key == app::getFrameCacheKey(path, 0, time, options));
+            DJV_ASSERT(key != app::getFrameCacheKey(path, 1, time, options));
+            DJV_ASSERT(key != app::getFrameCacheKey(path, 0, OTIO_NS::RationalTime(2.0, 24.0), options));
+            DJV_ASSERT(key != app::getFrameCacheKey(path, 0, OTIO_NS::RationalTime(1.0, 30.0), options));
+            DJV_ASSERT(key != app::getFrameCacheKey(path, 0, time, tl::io::Options()));
+            options["Option"] = "2";
+            DJV_ASSERT(key != app::getFrameCacheKey(path, 0, time, options));
+        }
+
+        void FrameCacheModelTest::_reference()
+        {
+            // The cache only keeps weak references to the images.
+            auto model = app::FrameCacheModel::create();
+            auto image = feather_tk::Image::create(feather_tk::ImageInfo(
+                feather_tk::Size2I(16, 16),
+                feather_tk::ImageType::RGBA_U8));
+            auto video = getVideo(image, 1.0);
+            model->add("a", video);
+            DJV_ASSERT(model->contains("a"));
+            DJV_ASSERT(!model->contains("b"));
+            tl::timeline::VideoData out;
+            DJV_ASSERT(model->get("a", out));
+            DJV_ASSERT(out.time.strictly_equal(video.time));
+            DJV_ASSERT(1 == out.layers.size());
+            DJV_ASSERT(image == out.layers[0].image);
+
+            // The frame can no longer be found when the image is released.
+            out = tl::timeline::VideoData();
+            video = tl::timeline::VideoData();
+            image.reset();
+            DJV_ASSERT(!model->contains("a"));
+            DJV_ASSERT(!model->get("a", out));
+        }
+
+        void FrameCacheModelTest::_lru()
+        {
+            auto model = app::FrameCacheModel::create();
+            auto image = feather_tk::Image::create(feather_tk::ImageInfo(
+                feather_tk::Size2I(16, 16),
+                feather_tk::ImageType::RGBA_U8));
+            model->add("a", getVideo(image, 0.0));
+            for (size_t i = 1; i < app::frameCacheMax; ++i)
+            {
+                std::stringstream ss;
+                ss << i;
+                model->add(ss.str(), getVideo(image, static_cast<double>(i)));
+            }
+            DJV_ASSERT(model->contains("a"));
+            DJV_ASSERT(model->contains("1"));
+
+            // Getting a frame makes it the most recently used, so the next
+            // oldest frame is removed instead.
+            tl::timeline::VideoData out;
+            DJV_ASSERT(model->get("a", out));
+            model->add("b", getVideo(image, 0.0));
+            DJV_ASSERT(model->contains("a"));
+            DJV_ASSERT(!model->contains("1"));
+            DJV_ASSERT(model->contains("2"));
+            DJV_ASSERT(model->contains("b"));
+
+            model->clear();
+            DJV_ASSERT(!model->contains("a"));
+            DJV_ASSERT(!model->contains("b"));
+        }
+
+        void FrameCacheModelTest::_remove()
+        {
+            auto model = app::FrameCacheModel::create();
+            auto image = feather_tk::Image::create(feather_tk::ImageInfo(
+                feather_tk::Size2I(16, 16),
+                feather_tk::ImageType::RGBA_U8));
+            model->add("a.0001.exr;1", getVideo(image, 1.0));
+            model->add("a.0001.exr;2", getVideo(image, 2.0));
+            model->add("a.0002.exr;1", getVideo(image, 1.0));
+            model->remove("a.0001.exr");
+            DJV_ASSERT(!model->contains("a.0001.exr;1"));
+            DJV_ASSERT(!model->contains("a.0001.exr;2"));
+            DJV_ASSERT(model->contains("a.0002.exr;1"));
+        }
+    }
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAppTest/ITest.h>
+
+namespace djv
+{
+    namespace app_tests
+    {
+        class FrameCacheModelTest : public tests::ITest
+        {
+        protected:
+            FrameCacheModelTest();
+
+        public:
+            virtual ~FrameCacheModelTest();
+
+            static std::shared_ptr<FrameCacheModelTest> create();
+
+            void run() override;
+
+        private:
+            void _key();
+            void _reference();
+            void _lru();
+            void _remove();
+        };
+    }
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvAppTest/FrameTimingModelTest.h>
+
+#include <djvApp/Models/FrameTimingModel.h>
+
+namespace djv
+{
+    namespace app_tests
+    {
+        FrameTimingModelTest::FrameTimingModelTest() :
+            ITest("djv::app_tests::FrameTimingModelTest")
+        {}
+
+        FrameTimingModelTest::~FrameTimingModelTest()
+        {}
+
+        std::shared_ptr<FrameTimingModelTest> FrameTimingModelTest::create()
+        {
+            return std::shared_ptr<FrameTimingModelTest>(new FrameTimingModelTest);
+        }
+
+        void FrameTimingModelTest::run()
+        {
+            _elapsed();
+            _ring();
+        }
+
+        void FrameTimingModelTest::_elapsed()
+        {
+            app::FrameTiming timing;
+            DJV_ASSERT(!timing.has(app::FrameTimingStage::Request));
+            DJV_ASSERT(0.0 == timing.getElapsed(
+                app::FrameTimingStage::Request,
+                app::FrameTimingStage::Present));
+
+            timing.stages[static_cast<size_t>(app::FrameTimingStage::Request)] = 1000;
+            timing.stages[static_cast<size_t>(app::FrameTimingStage::Present)] = 3500;
+            DJV_ASSERT(timing.has(app::FrameTimingStage::Request));
+            DJV_ASSERT(timing.has(app::FrameTimingStage::Present));
+            DJV_ASSERT(2.5 == timing.getElapsed(
+                app::FrameTimingStage::Request,
+                app::FrameTimingStage::Present));
+            DJV_ASSERT(0.0 == timing.getElapsed(
+                app::FrameTimingStage::Request,
+                app::FrameTimingStage::Video));
+
+            timing.set(app::FrameTimingStage::Video);
+            DJV_ASSERT(timing.has(app::FrameTimingStage::Video));
+        }
+
+        void FrameTimingModelTest::_ring()
+        {
+            auto model = app::FrameTimingModel::create();
+            const size_t capacity = model->getCapacity();
+            DJV_ASSERT(capacity > 0);
+            DJV_ASSERT(0 == model->getCount());
+            DJV_ASSERT(model->get(10).empty());
+
+            // Add fewer timings than the capacity.
+            for (size_t i = 0; i < 10; ++i)
+            {
+                app::FrameTiming timing;
+                timing.frame = static_cast<double>(i);
+                model->add(timing);
+            }
+            DJV_ASSERT(10 == model->getCount());
+            auto timings = model->get(capacity);
+            DJV_ASSERT(10 == timings.size());
+            DJV_ASSERT(0.0 == timings.front().frame);
+            DJV_ASSERT(9.0 == timings.back().frame);
+
+            // Wrap around the ring, only the most recent timings are kept
+            // and they are returned from oldest to newest.
+            for (size_t i = 10; i < capacity + 10; ++i)
+            {
+                app::FrameTiming timing;
+                timing.frame = static_cast<double>(i);
+                model->add(timing);
+            }
+            DJV_ASSERT(capacity + 10 == model->getCount());
+            timings = model->get(capacity * 2);
+            DJV_ASSERT(capacity == timings.size());
+            DJV_ASSERT(10.0 == timings.front().frame);
+            DJV_ASSERT(static_cast<double>(capacity + 9) == timings.back().frame);
+            timings = model->get(5);
+            DJV_ASSERT(5 == timings.size());
+            for (size_t i = 0; i < timings.size(); ++i)
+            {
+                DJV_ASSERT(static_cast<double>(capacity + 5 + i) == timings[i].frame);
+            }
+        }
+    }
+}
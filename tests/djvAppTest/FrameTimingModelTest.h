@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAppTest/ITest.h>
+
+namespace djv
+{
+    namespace app_tests
+    {
+        class FrameTimingModelTest : public tests::ITest
+        {
+        protected:
+            FrameTimingModelTest();
+
+        public:
+            virtual ~FrameTimingModelTest();
+
+            static std::shared_ptr<FrameTimingModelTest> create();
+
+            void run() override;
+
+        private:
+            void _elapsed();
+            void _ring();
+        };
+    }
+}
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvAppTest/ITest.h>
+
+#include <feather-tk/core/Format.h>
+
+#include <iostream>
+#include <stdexcept>
+
+namespace djv
+{
+    namespace tests
+    {
+        ITest::ITest(const std::string& name) :
+            _name(name)
+        {}
+
+        ITest::~ITest()
+        {}
+
+        const std::string& ITest::getName() const
+        {
+            return _name;
+        }
+
+        void ITest::_print(const std::string& value)
+        {
+            std::cout << _name << ": " << value << std::endl;
+        }
+
+        void ITest::_assert(
+            bool value,
+            const std::string& expression,
+            const char* file,
+            int line)
+        {
+            if (!value)
+            {
+                throw std::runtime_error(feather_tk::Format("{0}:{1}: Assertion failed: {2}").
+                    arg(file).
+                    arg(line).
+                    arg(expression));
+            }
+        }
+    }
+}
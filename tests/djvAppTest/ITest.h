@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/core/Util.h>
+
+#include <memory>
+#include <string>
+
+namespace djv
+{
+    namespace tests
+    {
+        //! Base class for tests.
+        class ITest : public std::enable_shared_from_this<ITest>
+        {
+            FEATHER_TK_NON_COPYABLE(ITest);
+
+        protected:
+            ITest(const std::string& name);
+
+        public:
+            virtual ~ITest() = 0;
+
+            //! Get the test name.
+            const std::string& getName() const;
+
+            //! Run the test.
+            virtual void run() = 0;
+
+        protected:
+            void _print(const std::string&);
+
+            //! Throw an exception if the value is false.
+            void _assert(
+                bool value,
+                const std::string& expression,
+                const char* file,
+                int line);
+
+            std::string _name;
+        };
+    }
+}
+
+//! Check a test condition.
+#define DJV_ASSERT(value) \
+    _assert(value, #value, __FILE__, __LINE__)
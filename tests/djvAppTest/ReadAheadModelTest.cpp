@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvAppTest/ReadAheadModelTest.h>
+
+#include <djvApp/Models/ReadAheadModel.h>
+
+namespace djv
+{
+    namespace app_tests
+    {
+        ReadAheadModelTest::ReadAheadModelTest() :
+            ITest("djv::app_tests::ReadAheadModelTest")
+        {}
+
+        ReadAheadModelTest::~ReadAheadModelTest()
+        {}
+
+        std::shared_ptr<ReadAheadModelTest> ReadAheadModelTest::create()
+        {
+            return std::shared_ptr<ReadAheadModelTest>(new ReadAheadModelTest);
+        }
+
+        void ReadAheadModelTest::run()
+        {
+            _speed();
+            _loop();
+            _range();
+        }
+
+        void ReadAheadModelTest::_speed()
+        {
+            // The read behind is scaled by the speed multiplier, but it is
+            // not reduced for slower speeds.
+            DJV_ASSERT(0.5 == app::getReadBehind(0.5, 24.0, 24.0, tl::timeline::Loop::Once, 0.0, 0.0));
+            DJV_ASSERT(1.0 == app::getReadBehind(0.5, 48.0, 24.0, tl::timeline::Loop::Once, 0.0, 0.0));
+            DJV_ASSERT(1.0 == app::getReadBehind(0.5, -48.0, 24.0, tl::timeline::Loop::Once, 0.0, 0.0));
+            DJV_ASSERT(0.5 == app::getReadBehind(0.5, 12.0, 24.0, tl::timeline::Loop::Once, 0.0, 0.0));
+            DJV_ASSERT(0.5 == app::getReadBehind(0.5, 48.0, 0.0, tl::timeline::Loop::Once, 0.0, 0.0));
+
+            // The read behind is rounded to a tenth of a second.
+            DJV_ASSERT(0.1 == app::getReadBehind(0.12, 24.0, 24.0, tl::timeline::Loop::Once, 0.0, 0.0));
+        }
+
+        void ReadAheadModelTest::_loop()
+        {
+            // With ping-pong playback half of the cache is kept behind the
+            // current time.
+            DJV_ASSERT(2.0 == app::getReadBehind(0.5, 24.0, 24.0, tl::timeline::Loop::PingPong, 10.0, 4.0));
+            DJV_ASSERT(1.5 == app::getReadBehind(0.5, 24.0, 24.0, tl::timeline::Loop::PingPong, 3.0, 4.0));
+
+            // With loop playback the whole range is kept when it fits in
+            // the cache.
+            DJV_ASSERT(3.0 == app::getReadBehind(0.5, 24.0, 24.0, tl::timeline::Loop::Loop, 3.0, 10.0));
+            DJV_ASSERT(0.5 == app::getReadBehind(0.5, 24.0, 24.0, tl::timeline::Loop::Loop, 20.0, 10.0));
+
+            // The cache size is not known until a frame has been shown.
+            DJV_ASSERT(0.5 == app::getReadBehind(0.5, 24.0, 24.0, tl::timeline::Loop::Loop, 3.0, 0.0));
+        }
+
+        void ReadAheadModelTest::_range()
+        {
+            // The read behind is not larger than the in/out range.
+            DJV_ASSERT(2.0 == app::getReadBehind(5.0, 24.0, 24.0, tl::timeline::Loop::Once, 2.0, 10.0));
+            DJV_ASSERT(2.0 == app::getReadBehind(0.5, 120.0, 24.0, tl::timeline::Loop::Once, 2.0, 10.0));
+        }
+    }
+}
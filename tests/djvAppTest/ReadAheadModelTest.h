@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAppTest/ITest.h>
+
+namespace djv
+{
+    namespace app_tests
+    {
+        class ReadAheadModelTest : public tests::ITest
+        {
+        protected:
+            ReadAheadModelTest();
+
+        public:
+            virtual ~ReadAheadModelTest();
+
+            static std::shared_ptr<ReadAheadModelTest> create();
+
+            void run() override;
+
+        private:
+            void _speed();
+            void _loop();
+            void _range();
+        };
+    }
+}
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvAppTest/ThumbnailSchedulerTest.h>
+
+#include <djvApp/Models/ThumbnailScheduler.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace djv
+{
+    namespace app_tests
+    {
+        ThumbnailSchedulerTest::ThumbnailSchedulerTest() :
+            ITest("djv::app_tests::ThumbnailSchedulerTest")
+        {}
+
+        ThumbnailSchedulerTest::~ThumbnailSchedulerTest()
+        {}
+
+        std::shared_ptr<ThumbnailSchedulerTest> ThumbnailSchedulerTest::create()
+        {
+            return std::shared_ptr<ThumbnailSchedulerTest>(new ThumbnailSchedulerTest);
+        }
+
+        void ThumbnailSchedulerTest::run()
+        {
+            _priority();
+        }
+
+        void ThumbnailSchedulerTest::_priority()
+        {
+            app::ThumbnailPriority a;
+            a.visible = false;
+            a.priority = 0;
+            a.order = 0;
+            app::ThumbnailPriority b;
+            b.visible = true;
+            b.priority = 5;
+            b.order = 1;
+            app::ThumbnailPriority c;
+            c.visible = true;
+            c.priority = 1;
+            c.order = 3;
+            app::ThumbnailPriority d;
+            d.visible = true;
+            d.priority = 1;
+            d.order = 2;
+
+            // Visible requests come first, then the lowest priority value,
+            // then the oldest request.
+            DJV_ASSERT(b < a);
+            DJV_ASSERT(c < b);
+            DJV_ASSERT(d < c);
+            DJV_ASSERT(!(a < a));
+
+            std::vector<app::ThumbnailPriority> priorities = { a, b, c, d };
+            std::sort(priorities.begin(), priorities.end());
+            DJV_ASSERT(2 == priorities[0].order);
+            DJV_ASSERT(3 == priorities[1].order);
+            DJV_ASSERT(1 == priorities[2].order);
+            DJV_ASSERT(0 == priorities[3].order);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAppTest/ITest.h>
+
+namespace djv
+{
+    namespace app_tests
+    {
+        class ThumbnailSchedulerTest : public tests::ITest
+        {
+        protected:
+            ThumbnailSchedulerTest();
+
+        public:
+            virtual ~ThumbnailSchedulerTest();
+
+            static std::shared_ptr<ThumbnailSchedulerTest> create();
+
+            void run() override;
+
+        private:
+            void _priority();
+        };
+    }
+}
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvAppTest/WaveformModelTest.h>
+
+#include <djvApp/Models/WaveformModel.h>
+
+namespace djv
+{
+    namespace app_tests
+    {
+        WaveformModelTest::WaveformModelTest() :
+            ITest("djv::app_tests::WaveformModelTest")
+        {}
+
+        WaveformModelTest::~WaveformModelTest()
+        {}
+
+        std::shared_ptr<WaveformModelTest> WaveformModelTest::create()
+        {
+            return std::shared_ptr<WaveformModelTest>(new WaveformModelTest);
+        }
+
+        void WaveformModelTest::run()
+        {
+            _levels();
+            _peaks();
+        }
+
+        namespace
+        {
+            std::vector<app::WaveformPeak> getPeaks(size_t size)
+            {
+                std::vector<app::WaveformPeak> out(size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    out[i].min = -(i / 10.F);
+                    out[i].max = i / 10.F;
+                }
+                return out;
+            }
+        }
+
+        void WaveformModelTest::_levels()
+        {
+            // Each level has half as many peaks as the previous one, the
+            // last peak of an odd level is carried over.
+            const auto levels = app::getWaveformLevels(getPeaks(5));
+            DJV_ASSERT(4 == levels.size());
+            DJV_ASSERT(5 == levels[0].size());
+            DJV_ASSERT(3 == levels[1].size());
+            DJV_ASSERT(2 == levels[2].size());
+            DJV_ASSERT(1 == levels[3].size());
+            DJV_ASSERT(-(1 / 10.F) == levels[1][0].min);
+            DJV_ASSERT(1 / 10.F == levels[1][0].max);
+            DJV_ASSERT(4 / 10.F == levels[1][2].max);
+            DJV_ASSERT(-(4 / 10.F) == levels[3][0].min);
+            DJV_ASSERT(4 / 10.F == levels[3][0].max);
+
+            const auto empty = app::getWaveformLevels({});
+            DJV_ASSERT(1 == empty.size());
+            DJV_ASSERT(empty[0].empty());
+        }
+
+        void WaveformModelTest::_peaks()
+        {
+            const double rate = 48000.0;
+            app::Waveform waveform;
+            waveform.timeRange = OTIO_NS::TimeRange(
+                OTIO_NS::RationalTime(0.0, rate),
+                OTIO_NS::RationalTime(app::waveformSamples * 8, rate));
+            waveform.levels = app::getWaveformLevels(getPeaks(8));
+
+            DJV_ASSERT(waveform.getPeaks(waveform.timeRange, 0).empty());
+            DJV_ASSERT(app::Waveform().getPeaks(waveform.timeRange, 8).empty());
+
+            // One pixel for each peak of the first level.
+            auto peaks = waveform.getPeaks(waveform.timeRange, 8);
+            DJV_ASSERT(8 == peaks.size());
+            for (size_t i = 0; i < peaks.size(); ++i)
+            {
+                DJV_ASSERT(-(i / 10.F) == peaks[i].min);
+                DJV_ASSERT(i / 10.F == peaks[i].max);
+            }
+
+            // Each pixel covers four peaks of the first level.
+            peaks = waveform.getPeaks(waveform.timeRange, 2);
+            DJV_ASSERT(2 == peaks.size());
+            DJV_ASSERT(-(3 / 10.F) == peaks[0].min);
+            DJV_ASSERT(3 / 10.F == peaks[0].max);
+            DJV_ASSERT(-(7 / 10.F) == peaks[1].min);
+            DJV_ASSERT(7 / 10.F == peaks[1].max);
+
+            // The second half of the waveform.
+            peaks = waveform.getPeaks(
+                OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(app::waveformSamples * 4, rate),
+                    OTIO_NS::RationalTime(app::waveformSamples * 4, rate)),
+                4);
+            DJV_ASSERT(4 == peaks.size());
+            for (size_t i = 0; i < peaks.size(); ++i)
+            {
+                DJV_ASSERT((4 + i) / 10.F == peaks[i].max);
+            }
+        }
+    }
+}
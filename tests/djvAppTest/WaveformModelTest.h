@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAppTest/ITest.h>
+
+namespace djv
+{
+    namespace app_tests
+    {
+        class WaveformModelTest : public tests::ITest
+        {
+        protected:
+            WaveformModelTest();
+
+        public:
+            virtual ~WaveformModelTest();
+
+            static std::shared_ptr<WaveformModelTest> create();
+
+            void run() override;
+
+        private:
+            void _levels();
+            void _peaks();
+        };
+    }
+}
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvAppTest/FrameCacheModelTest.h>
+#include <djvAppTest/FrameTimingModelTest.h>
+#include <djvAppTest/ReadAheadModelTest.h>
+#include <djvAppTest/ThumbnailSchedulerTest.h>
+#include <djvAppTest/WaveformModelTest.h>
+
+#include <iostream>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    // Run all of the tests, or only the tests named on the command line.
+    std::vector<std::shared_ptr<djv::tests::ITest> > tests;
+    tests.push_back(djv::app_tests::FrameCacheModelTest::create());
+    tests.push_back(djv::app_tests::FrameTimingModelTest::create());
+    tests.push_back(djv::app_tests::ReadAheadModelTest::create());
+    tests.push_back(djv::app_tests::ThumbnailSchedulerTest::create());
+    tests.push_back(djv::app_tests::WaveformModelTest::create());
+    int r = 0;
+    for (const auto& test : tests)
+    {
+        bool run = argc < 2;
+        for (int i = 1; i < argc; ++i)
+        {
+            run |= test->getName() == argv[i];
+        }
+        if (run)
+        {
+            std::cout << "Running test: " << test->getName() << std::endl;
+            try
+            {
+                test->run();
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "ERROR: " << e.what() << std::endl;
+                r = 1;
+            }
+        }
+    }
+    return r;
+}
@@ -0,0 +1,334 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvBenchmark/BenchmarkApp.h>
+
+#include <djvApp/Models/FilesModel.h>
+#include <djvApp/Models/SettingsModel.h>
+
+#include <tlTimeline/Util.h>
+
+#include <tlIO/System.h>
+
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/Format.h>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace djv
+{
+    namespace benchmark
+    {
+        namespace
+        {
+            //! Temporary directory that is removed when it goes out of
+            //! scope, also when the benchmark throws an exception.
+            class TempDir
+            {
+                FEATHER_TK_NON_COPYABLE(TempDir);
+
+            public:
+                TempDir()
+                {
+                    // Each run gets a unique directory, so that concurrent
+                    // runs do not overwrite or remove each other's files.
+                    std::random_device rd;
+                    std::mt19937_64 rng(rd());
+                    const std::filesystem::path tempPath = std::filesystem::temp_directory_path();
+                    bool created = false;
+                    while (!created)
+                    {
+                        _path = tempPath / ("djv_benchmark_" + std::to_string(rng()));
+                        created = std::filesystem::create_directory(_path);
+                    }
+                }
+
+                ~TempDir()
+                {
+                    std::error_code ec;
+                    std::filesystem::remove_all(_path, ec);
+                }
+
+                const std::filesystem::path& getPath() const
+                {
+                    return _path;
+                }
+
+            private:
+                std::filesystem::path _path;
+            };
+        }
+
+        struct BenchmarkApp::Private
+        {
+            Options options;
+            std::chrono::steady_clock::time_point startTime;
+            bool started = false;
+        };
+
+        void BenchmarkApp::_init(
+            const std::shared_ptr<feather_tk::Context>& context,
+            std::vector<std::string>& argv,
+            const Options& options)
+        {
+            App::_init(context, argv);
+            FEATHER_TK_P();
+            p.options = options;
+        }
+
+        BenchmarkApp::BenchmarkApp() :
+            _p(new Private)
+        {}
+
+        BenchmarkApp::~BenchmarkApp()
+        {}
+
+        std::shared_ptr<BenchmarkApp> BenchmarkApp::create(
+            const std::shared_ptr<feather_tk::Context>& context,
+            std::vector<std::string>& argv,
+            const Options& options)
+        {
+            auto out = std::shared_ptr<BenchmarkApp>(new BenchmarkApp);
+            out->_init(context, argv, options);
+            return out;
+        }
+
+        void BenchmarkApp::run()
+        {
+            _p->startTime = std::chrono::steady_clock::now();
+            App::run();
+        }
+
+        void BenchmarkApp::_tick()
+        {
+            App::_tick();
+            FEATHER_TK_P();
+            if (!p.started)
+            {
+                p.started = true;
+                _benchmark();
+                exit();
+            }
+        }
+
+        void BenchmarkApp::_benchmark()
+        {
+            FEATHER_TK_P();
+            nlohmann::json json;
+            std::chrono::duration<double> diff = std::chrono::steady_clock::now() - p.startTime;
+            json["startup"] = diff.count() * 1000.0;
+
+            // Write the synthetic image sequence.
+            std::vector<std::string> inputs = p.options.inputs;
+            std::unique_ptr<TempDir> syntheticDir;
+            if (p.options.synthetic > 0)
+            {
+                syntheticDir.reset(new TempDir);
+                const tl::file::Path path((syntheticDir->getPath() / "djv_benchmark.0000.ppm").u8string());
+                auto ioSystem = _context->getSystem<tl::io::WriteSystem>();
+                auto plugin = ioSystem->getPlugin(path);
+                if (!plugin)
+                {
+                    throw std::runtime_error(
+                        feather_tk::Format("Cannot open: \"{0}\"").arg(path.get()));
+                }
+                tl::io::Info info;
+                info.video.push_back(feather_tk::ImageInfo(
+                    feather_tk::Size2I(1920, 1080),
+                    feather_tk::ImageType::RGB_U8));
+                info.videoTime = OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(0.0, 24.0),
+                    OTIO_NS::RationalTime(p.options.synthetic, 24.0));
+                auto writer = plugin->write(path, info, tl::io::Options());
+                auto image = feather_tk::Image::create(info.video.front());
+                for (size_t i = 0; i < p.options.synthetic; ++i)
+                {
+                    std::memset(image->getData(), i % 256, image->getByteCount());
+                    writer->writeVideo(OTIO_NS::RationalTime(i, 24.0), image);
+                }
+                inputs.push_back(path.get());
+            }
+            if (inputs.empty())
+            {
+                throw std::runtime_error("The benchmark requires an input");
+            }
+
+            // Measure the time to add each input, create the timeline, show
+            // the first frame, and fill the cache.
+            auto filesModel = getFilesModel();
+            nlohmann::json inputsJson = nlohmann::json::array();
+            for (const auto& input : inputs)
+            {
+                nlohmann::json inputJson;
+                inputJson["path"] = input;
+                const size_t fileCount = filesModel->getFiles().size();
+                const auto t0 = std::chrono::steady_clock::now();
+                tl::file::PathOptions pathOptions;
+                pathOptions.maxNumberDigits = getSettingsModel()->getImageSequence().maxDigits;
+                for (const auto& path : tl::timeline::getPaths(_context, tl::file::Path(input), pathOptions))
+                {
+                    auto item = std::make_shared<app::FilesModelItem>();
+                    item->path = path;
+                    filesModel->add(item);
+                }
+                diff = std::chrono::steady_clock::now() - t0;
+                inputJson["add"] = diff.count() * 1000.0;
+                if (filesModel->getFiles().size() > fileCount)
+                {
+                    auto item = filesModel->getA();
+                    inputJson["timeline"] = _wait(
+                        [item]
+                        {
+                            return !item->loading;
+                        });
+                    inputJson["firstFrame"] = _wait(
+                        [this]
+                        {
+                            return _hasVideo(1);
+                        });
+                    diff = std::chrono::steady_clock::now() - t0;
+                    inputJson["timeToFirstFrame"] = diff.count() * 1000.0;
+
+                    // The cache is considered full when it has not changed
+                    // for one second.
+                    int64_t cacheFrames = 0;
+                    const auto t1 = std::chrono::steady_clock::now();
+                    auto cacheTime = t1;
+                    _wait(
+                        [this, &cacheFrames, &cacheTime]
+                        {
+                            int64_t frames = 0;
+                            if (auto player = observePlayer()->get())
+                            {
+                                for (const auto& range : player->observeCacheInfo()->get().video)
+                                {
+                                    frames += range.duration().value();
+                                }
+                            }
+                            const auto now = std::chrono::steady_clock::now();
+                            if (frames != cacheFrames)
+                            {
+                                cacheFrames = frames;
+                                cacheTime = now;
+                            }
+                            const std::chrono::duration<double> diff = now - cacheTime;
+                            return diff.count() > 1.0;
+                        });
+                    diff = cacheTime - t1;
+                    inputJson["cacheFrames"] = cacheFrames;
+                    inputJson["cacheFill"] = diff.count() > 0.0 ? (cacheFrames / diff.count()) : 0.0;
+                }
+                else
+                {
+                    inputJson["error"] = feather_tk::Format("Cannot open: \"{0}\"").arg(input).str();
+                }
+                inputsJson.push_back(inputJson);
+            }
+            json["inputs"] = inputsJson;
+
+            // Measure the time to switch the A and B files.
+            const int fileCount = filesModel->getFiles().size();
+            if (fileCount > 1)
+            {
+                nlohmann::json switchAJson = nlohmann::json::array();
+                for (int i = 0; i < fileCount; ++i)
+                {
+                    filesModel->setA(i);
+                    switchAJson.push_back(_wait(
+                        [this]
+                        {
+                            return _hasVideo(1);
+                        }));
+                }
+                json["switchA"] = switchAJson;
+
+                nlohmann::json switchBJson = nlohmann::json::array();
+                for (int i = 0; i < fileCount - 1; ++i)
+                {
+                    filesModel->setB(i, true);
+                    switchBJson.push_back(_wait(
+                        [this]
+                        {
+                            return _hasVideo(2);
+                        }));
+                    filesModel->setB(i, false);
+                }
+                json["switchB"] = switchBJson;
+            }
+
+            filesModel->closeAll();
+            _wait(
+                [this]
+                {
+                    return !observePlayer()->get();
+                });
+            syntheticDir.reset();
+
+            // Write the results.
+            std::ofstream file(std::filesystem::u8path(p.options.fileName));
+            if (!file.is_open())
+            {
+                throw std::runtime_error(
+                    feather_tk::Format("Cannot open: \"{0}\"").arg(p.options.fileName));
+            }
+            file << json.dump(4);
+            std::cout << "Benchmark: " << p.options.fileName << std::endl;
+        }
+
+        double BenchmarkApp::_wait(const std::function<bool(void)>& condition)
+        {
+            // Run the application until the condition is true or the
+            // timeout is reached. Returns the elapsed time in milliseconds,
+            // or -1 on timeout.
+            FEATHER_TK_P();
+            double out = -1.0;
+            const auto t0 = std::chrono::steady_clock::now();
+            while (out < 0.0)
+            {
+                const std::chrono::duration<double> diff = std::chrono::steady_clock::now() - t0;
+                if (condition())
+                {
+                    out = diff.count() * 1000.0;
+                }
+                else if (diff.count() > p.options.timeout)
+                {
+                    break;
+                }
+                else
+                {
+                    _context->tick();
+                    App::_tick();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+            return out;
+        }
+
+        bool BenchmarkApp::_hasVideo(size_t count) const
+        {
+            bool out = false;
+            if (auto player = observePlayer()->get())
+            {
+                const auto& video = player->observeCurrentVideo()->get();
+                out = video.size() >= count;
+                for (size_t i = 0; i < count && out; ++i)
+                {
+                    out = !video[i].layers.empty() && video[i].layers.front().image;
+                }
+            }
+            return out;
+        }
+    }
+}
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvApp/App.h>
+
+#include <functional>
+
+namespace djv
+{
+    namespace benchmark
+    {
+        //! Benchmark options.
+        struct Options
+        {
+            //! The JSON file for the results.
+            std::string fileName;
+
+            //! The inputs to open.
+            std::vector<std::string> inputs;
+
+            //! The number of frames in a synthetic image sequence that is
+            //! written to a temporary directory and added to the inputs.
+            size_t synthetic = 0;
+
+            //! The maximum time in seconds to wait for each measurement.
+            double timeout = 10.0;
+        };
+
+        //! Benchmark application.
+        //!
+        //! This runs the application and measures the time to open the
+        //! inputs, show the first frames, fill the cache, and switch the
+        //! A and B files. The measurements are run on the first tick, then
+        //! the results are written and the application exits.
+        class BenchmarkApp : public app::App
+        {
+            FEATHER_TK_NON_COPYABLE(BenchmarkApp);
+
+        protected:
+            void _init(
+                const std::shared_ptr<feather_tk::Context>&,
+                std::vector<std::string>&,
+                const Options&);
+
+            BenchmarkApp();
+
+        public:
+            ~BenchmarkApp();
+
+            //! Create a new application.
+            static std::shared_ptr<BenchmarkApp> create(
+                const std::shared_ptr<feather_tk::Context>&,
+                std::vector<std::string>&,
+                const Options&);
+
+            void run() override;
+
+        protected:
+            void _tick() override;
+
+        private:
+            void _benchmark();
+            double _wait(const std::function<bool(void)>&);
+            bool _hasVideo(size_t count) const;
+
+            FEATHER_TK_PRIVATE();
+        };
+    }
+}
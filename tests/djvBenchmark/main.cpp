@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2025 Darby Johnston
+// All rights reserved.
+
+#include <djvBenchmark/BenchmarkApp.h>
+
+#include <tlTimelineUI/Init.h>
+#include <tlDevice/Init.h>
+
+#include <feather-tk/core/Context.h>
+
+#include <iostream>
+
+FEATHER_TK_MAIN()
+{
+    int r = 1;
+    try
+    {
+        // Parse the benchmark arguments, the application only gets the
+        // program name so that it does not open the inputs itself.
+        auto args = feather_tk::convert(argc, argv);
+        djv::benchmark::Options options;
+        for (size_t i = 1; i < args.size(); ++i)
+        {
+            if ("-synthetic" == args[i] && i + 1 < args.size())
+            {
+                options.synthetic = std::stoul(args[++i]);
+            }
+            else if ("-timeout" == args[i] && i + 1 < args.size())
+            {
+                options.timeout = std::stod(args[++i]);
+            }
+            else if (options.fileName.empty())
+            {
+                options.fileName = args[i];
+            }
+            else
+            {
+                options.inputs.push_back(args[i]);
+            }
+        }
+        if (options.fileName.empty())
+        {
+            std::cout << "Usage: djvBenchmark (results.json) [-synthetic (frames)] "
+                "[-timeout (seconds)] [input ...]" << std::endl;
+        }
+        else
+        {
+            auto context = feather_tk::Context::create();
+            tl::timelineui::init(context);
+            tl::device::init(context);
+            std::vector<std::string> appArgs;
+            if (!args.empty())
+            {
+                appArgs.push_back(args.front());
+            }
+            auto app = djv::benchmark::BenchmarkApp::create(context, appArgs, options);
+            r = app->getExit();
+            if (0 == r)
+            {
+                app->run();
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        r = 1;
+    }
+    return r;
+}